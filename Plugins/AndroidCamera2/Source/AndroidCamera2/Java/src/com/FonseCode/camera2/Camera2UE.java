@@ -44,7 +44,6 @@ import java.util.Collections;
 import java.util.Comparator;
 import java.util.Date;
 import java.util.Locale;
-import java.util.concurrent.atomic.AtomicReference;
 
 public final class Camera2UE {
 
@@ -60,6 +59,17 @@ public final class Camera2UE {
         public int imgWidth, imgHeight;
         public int Orientation; //0->0 degress, 1->90 degress, 2->180 degress, 3->270 degress
         public long timeStamp;
+        public long conversionNanos; // tiempo de packtoI420Lib (conversión + rotación)
+        // Trazado por etapas: ns desde initialCamTime (base elapsedRealtimeNanos)
+        public long frameNumber;
+        public long exposureNanos;   // inicio de exposición del sensor
+        public long arrivalNanos;    // entrada en onYuvImage
+        public long convertedNanos;  // fin de packtoI420Lib
+        // Contadores de la sesión, copiados al entregar el frame (getLastFrameInfo)
+        public long sensorFrames;      // capturas completadas por el sensor
+        public long imagesAcquired;    // imágenes recibidas del ImageReader
+        public long droppedDrain;      // descartadas por el drenado del listener (solo se usa la última)
+        public long droppedBusy;       // descartadas porque C++ estaba leyendo FrameInfo
         private void setOutputDataAndPointers()
         {
             if(Orientation==0) {
@@ -130,8 +140,14 @@ public final class Camera2UE {
 
     private long initialCamTime =0;
     private long SensorOffsetTime = -1;
+    private boolean bSensorTimestampRealtime = false; // SENSOR_INFO_TIMESTAMP_SOURCE == REALTIME
 
     private long framecounter = 0;
+    // Escritos solo en el hilo de fondo de la cámara
+    private volatile long sensorFrames = 0;
+    private volatile long imagesAcquired = 0;
+    private volatile long droppedDrain = 0;
+    private volatile long droppedBusy = 0;
     FrameUpdateInfo FrameInfo = new FrameUpdateInfo();
 
 
@@ -153,8 +169,19 @@ public final class Camera2UE {
     private CaptureRequest.Builder previewBuilder;
     private CaptureRequest previewRequest;
 
-    // ultimos datos capturados
-    private final AtomicReference<byte[]> lastJpeg = new AtomicReference<>(null); // still JPEG
+    // ultimo JPEG capturado: dos buffers directos reutilizables, C++ lee uno sin copias mientras el otro recibe la siguiente foto
+    public class JpegInfo {
+        public ByteBuffer buffer;
+        public int length;
+        public long sequence;
+    }
+    private final Object jpegLock = new Object();
+    private final ByteBuffer[] jpegBuffers = new ByteBuffer[2];
+    private final int[] jpegLengths = new int[2];
+    private int jpegLatest = -1;    // buffer con el ultimo JPEG
+    private int jpegLocked = -1;    // buffer que C++ esta leyendo (lockLastJpeg/releaseLastJpeg)
+    private volatile long jpegSequence = 0;
+    private final JpegInfo jpegInfo = new JpegInfo();
 
 
     // Tamanos/outputs
@@ -251,6 +278,9 @@ public final class Camera2UE {
             StreamConfigurationMap map = cc.get(CameraCharacteristics.SCALER_STREAM_CONFIGURATION_MAP);
             if (map == null) { Log.e(TAG, "initializeCamera:No StreamConfigurationMap"); return false; }
 
+            Integer tsSource = cc.get(CameraCharacteristics.SENSOR_INFO_TIMESTAMP_SOURCE);
+            bSensorTimestampRealtime = tsSource != null && tsSource == CameraMetadata.SENSOR_INFO_TIMESTAMP_SOURCE_REALTIME;
+
             // Resolver modos 3A
             resolve3AModesSimple(cc, AE_ModeIn, AF_ModeIn, AWB_ModeIn, ControlModeIn);
 
@@ -329,8 +359,28 @@ public final class Camera2UE {
         }
     }
 
-    /** Devuelve el último JPEG capturado (puede ser null si aún no has disparado). */
-    public byte[] getLastCapturedImage() { return lastJpeg.get(); }
+    /** Secuencia del último JPEG capturado (0 si aún no has disparado). No bloquea: se puede consultar cada tick. */
+    public long getLastJpegSequence() { return jpegSequence; }
+
+    /**
+     * Bloquea el buffer directo con el último JPEG para que C++ lo lea sin copias hasta releaseLastJpeg().
+     * Una foto que llegue mientras tanto se escribe en el otro buffer. null si no hay JPEG o ya hay uno bloqueado.
+     */
+    @Nullable
+    public JpegInfo lockLastJpeg() {
+        synchronized (jpegLock) {
+            if (jpegLatest < 0 || jpegLocked >= 0) return null;
+            jpegLocked = jpegLatest;
+            jpegInfo.buffer = jpegBuffers[jpegLocked];
+            jpegInfo.length = jpegLengths[jpegLocked];
+            jpegInfo.sequence = jpegSequence;
+            return jpegInfo;
+        }
+    }
+
+    public void releaseLastJpeg() {
+        synchronized (jpegLock) { jpegLocked = -1; }
+    }
 
     /** Dispara una foto JPEG con secuencia 3A: AF lock + AE precapture + still. */
     public synchronized boolean takePhoto() {
@@ -375,6 +425,7 @@ public final class Camera2UE {
         }
 
         @Override public void onCaptureCompleted(CameraCaptureSession session, CaptureRequest request, TotalCaptureResult result) {
+            sensorFrames++;
             process(result);
         }
 
@@ -504,11 +555,17 @@ public final class Camera2UE {
     public synchronized String saveResult() {
         
         try {
-            byte[] lastJpegbytes = lastJpeg.get();
-
-            if (lastJpegbytes == null || lastJpegbytes.length == 0) {
-                Log.e(TAG, "saveResult: no data");
-                return null;
+            byte[] lastJpegbytes;
+            synchronized (jpegLock) {
+                if (jpegLatest < 0 || jpegLengths[jpegLatest] == 0) {
+                    Log.e(TAG, "saveResult: no data");
+                    return null;
+                }
+                ByteBuffer src = jpegBuffers[jpegLatest].duplicate();
+                src.clear();
+                src.limit(jpegLengths[jpegLatest]);
+                lastJpegbytes = new byte[jpegLengths[jpegLatest]];
+                src.get(lastJpegbytes);
             }
 
             File outFile = createTimestampedFile(appContext, "jpg");
@@ -534,6 +591,10 @@ public final class Camera2UE {
         }
         stopBgThread();
         framecounter = 0;
+        sensorFrames = 0;
+        imagesAcquired = 0;
+        droppedDrain = 0;
+        droppedBusy = 0;
         Log.d(TAG, "release: ok");
     }
 
@@ -669,16 +730,27 @@ public final class Camera2UE {
         return nearestSize;
     }
 
-    // Listener JPEG: guardar bytes en lastJpeg
+    // Listener JPEG: copiar al buffer directo libre, sin byte[] por foto
     private final ImageReader.OnImageAvailableListener jpegListener = reader -> {
         Image image = null;
         try {
             image = reader.acquireLatestImage();
             if (image != null) {
                 ByteBuffer buf = image.getPlanes()[0].getBuffer();
-                byte[] out = new byte[buf.remaining()];
-                buf.get(out);
-                lastJpeg.set(out);
+                int size = buf.remaining();
+                synchronized (jpegLock) {
+                    // Nunca el que C++ está leyendo; si no lee ninguno, el que no tiene el último JPEG
+                    int idx = (jpegLocked >= 0) ? 1 - jpegLocked : (jpegLatest == 0 ? 1 : 0);
+                    if (jpegBuffers[idx] == null || jpegBuffers[idx].capacity() < size) {
+                        jpegBuffers[idx] = NativeYuv.allocDirect(size + size / 4); // margen: el tamaño del JPEG varía entre fotos
+                    }
+                    ByteBuffer dst = jpegBuffers[idx];
+                    dst.clear();
+                    dst.put(buf);
+                    jpegLengths[idx] = size;
+                    jpegLatest = idx;
+                    jpegSequence++;
+                }
             }
         } catch (Throwable t) {
             Log.e(TAG, "jpegListener: error:", t);
@@ -693,7 +765,8 @@ public final class Camera2UE {
         try {
             Image drain;
             while ((drain = reader.acquireNextImage()) != null) {
-                if (image != null) { drain.close(); continue; }
+                imagesAcquired++;
+                if (image != null) { droppedDrain++; drain.close(); continue; }
                 image = drain;
             }
             if (image != null) {
@@ -712,6 +785,7 @@ public final class Camera2UE {
     {
         if (image.getFormat() != ImageFormat.YUV_420_888) throw new IllegalArgumentException("Format must be YUV_420_888");
         Trace.beginSection("packtoI420Lib");
+        final long t0 = System.nanoTime();
 
         int w = image.getCropRect().width(), h = image.getCropRect().height();
 
@@ -727,6 +801,11 @@ public final class Camera2UE {
                 SensorOffsetTime = image.getTimestamp() - ( android.os.SystemClock.elapsedRealtimeNanos()-initialCamTime);
         }
         FrameInfo.timeStamp = image.getTimestamp() - SensorOffsetTime;
+        FrameInfo.conversionNanos = System.nanoTime() - t0;
+        // Con base REALTIME el timestamp del sensor es comparable con elapsedRealtimeNanos;
+        // si no, se usa la estimación por offset (absorbe la latencia del primer frame).
+        FrameInfo.exposureNanos = bSensorTimestampRealtime ? image.getTimestamp() - initialCamTime : FrameInfo.timeStamp;
+        FrameInfo.convertedNanos = SystemClock.elapsedRealtimeNanos() - initialCamTime;
 
         Trace.endSection();
     }
@@ -774,6 +853,7 @@ public final class Camera2UE {
 
     // --- Productor (listener) ---
     private void onYuvImage(Image image) {
+        final long arrivalNanos = SystemClock.elapsedRealtimeNanos() - initialCamTime;
         int w = image.getWidth(), h = image.getHeight();
 
 
@@ -782,12 +862,18 @@ public final class Camera2UE {
 
             FrameInfo.ensureBufferSize(w, h);
 
+            FrameInfo.arrivalNanos = arrivalNanos;
             packtoI420Lib(image);
             framecounter++;
+            FrameInfo.frameNumber = framecounter;
             
             initialized = true;
             //Log.d(TAG, "FrameCounter=" + framecounter);
         }
+        else
+        {
+            droppedBusy++;
+        }
     }
 
     @Nullable
@@ -795,6 +881,10 @@ public final class Camera2UE {
 
         if(FrameInfo.reading.compareAndSet(false, true))
         {
+            FrameInfo.sensorFrames = sensorFrames;
+            FrameInfo.imagesAcquired = imagesAcquired;
+            FrameInfo.droppedDrain = droppedDrain;
+            FrameInfo.droppedBusy = droppedBusy;
             return FrameInfo;
         }
         return  null;
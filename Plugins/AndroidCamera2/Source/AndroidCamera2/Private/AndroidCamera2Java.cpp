@@ -34,7 +34,9 @@ FAndroidCamera2Java::FAndroidCamera2Java():FJavaClassObject(GetClassName(), "()V
 	InitializeCameraMethod = GetClassMethod("initializeCamera", "(Ljava/lang/String;IIIIIIIIII)Z");
 	TakePhotoMethod = GetClassMethod("takePhoto", "()Z"); 
 	getLastFrameInfoMethod = GetClassMethod("getLastFrameInfo", "()Lcom/FonseCode/camera2/Camera2UE$FrameUpdateInfo;");
-	GetLastCapturedImageMethod = GetClassMethod("getLastCapturedImage", "()[B"); 
+	getLastJpegSequenceMethod = GetClassMethod("getLastJpegSequence", "()J");
+	lockLastJpegMethod = GetClassMethod("lockLastJpeg", "()Lcom/FonseCode/camera2/Camera2UE$JpegInfo;");
+	releaseLastJpegMethod = GetClassMethod("releaseLastJpeg", "()V");
 	SaveResultMethod = GetClassMethod("saveResult", "()Ljava/lang/String;");
 	ReleaseMethod = GetClassMethod("release", "()V");
 	releaseFrameInfoMethod = GetClassMethod("releaseFrameInfo", "()V");
@@ -107,12 +109,65 @@ bool FAndroidCamera2Java::TakePhoto()
 	return CallMethod<bool>(TakePhotoMethod);
 }
 
-bool FAndroidCamera2Java::GetLastCapturedImage(TArray<uint8>& OutJpeg) const
+uint64 FAndroidCamera2Java::GetLastJpegSequence()
 {
-	return false;
+	return static_cast<uint64>(CallMethod<int64>(getLastJpegSequenceMethod));
+}
+
+bool FAndroidCamera2Java::LockLastJpeg(const uint8*& OutJpeg, int32& OutSize, uint64& OutSequence)
+{
+	JNIEnv* JEnv = FAndroidApplication::GetJavaEnv();
+	jobject Result = CallMethod<jobject>(lockLastJpegMethod);
+
+	if (!Result)
+	{
+		return false;
+	}
+
+	jclass JpegInfoClass = FAndroidApplication::FindJavaClassGlobalRef("com/FonseCode/camera2/Camera2UE$JpegInfo");
+	jfieldID JpegInfo_buffer = FindField(JEnv, JpegInfoClass, "buffer", "Ljava/nio/ByteBuffer;", false);
+	jfieldID JpegInfo_length = FindField(JEnv, JpegInfoClass, "length", "I", false);
+	jfieldID JpegInfo_sequence = FindField(JEnv, JpegInfoClass, "sequence", "J", false);
+
+	jobject Buffer = JEnv->GetObjectField(Result, JpegInfo_buffer);
+	OutJpeg = Buffer ? static_cast<const uint8*>(JEnv->GetDirectBufferAddress(Buffer)) : nullptr;
+	OutSize = static_cast<int32>(JEnv->GetIntField(Result, JpegInfo_length));
+	OutSequence = static_cast<uint64>(JEnv->GetLongField(Result, JpegInfo_sequence));
+	if (Buffer)
+	{
+		JEnv->DeleteLocalRef(Buffer);
+	}
+	JEnv->DeleteGlobalRef(Result);
+
+	if (!OutJpeg || OutSize <= 0)
+	{
+		ReleaseLastJpeg();
+		return false;
+	}
+	return true;
+}
+
+void FAndroidCamera2Java::ReleaseLastJpeg()
+{
+	CallMethod<void>(releaseLastJpegMethod);
+}
+
+bool FAndroidCamera2Java::GetLastCapturedImage(TArray<uint8>& OutJpeg)
+{
+	const uint8* Jpeg = nullptr;
+	int32 Size = 0;
+	uint64 Sequence = 0;
+	if (!LockLastJpeg(Jpeg, Size, Sequence))
+	{
+		return false;
+	}
+	OutJpeg.SetNumUninitialized(Size);
+	FMemory::Memcpy(OutJpeg.GetData(), Jpeg, Size);
+	ReleaseLastJpeg();
+	return true;
 }
 
-bool FAndroidCamera2Java::GetLastPreviewFrameInfo(void*& yPlaneBuffer, void*& uPlaneBuffer, void*& vPlaneBuffer, int32& previewWidth, int32& previewHeight, int64& timeStamp)
+bool FAndroidCamera2Java::GetLastPreviewFrameInfo(void*& yPlaneBuffer, void*& uPlaneBuffer, void*& vPlaneBuffer, int32& previewWidth, int32& previewHeight, int64& timeStamp, FAndroidCamera2JavaFrameTimes& frameTimes, FAndroidCamera2JavaFrameCounters& frameCounters)
 {
 	// This can return an exception in some cases
 	JNIEnv* JEnv = FAndroidApplication::GetJavaEnv();
@@ -140,6 +195,24 @@ bool FAndroidCamera2Java::GetLastPreviewFrameInfo(void*& yPlaneBuffer, void*& uP
 		previewWidth = (int32)JEnv->GetIntField(Result, FrameUpdateInfo_imgWidth);
 		previewHeight = (int32)JEnv->GetIntField(Result, FrameUpdateInfo_imgHeight);
 		timeStamp = (int64)JEnv->GetLongField(Result, FrameUpdateInfo_timeStamp);
+		jfieldID FrameUpdateInfo_conversionNanos = FindField(JEnv, FrameUpdateInfoClass, "conversionNanos", "J", false);
+		jfieldID FrameUpdateInfo_frameNumber = FindField(JEnv, FrameUpdateInfoClass, "frameNumber", "J", false);
+		jfieldID FrameUpdateInfo_exposureNanos = FindField(JEnv, FrameUpdateInfoClass, "exposureNanos", "J", false);
+		jfieldID FrameUpdateInfo_arrivalNanos = FindField(JEnv, FrameUpdateInfoClass, "arrivalNanos", "J", false);
+		jfieldID FrameUpdateInfo_convertedNanos = FindField(JEnv, FrameUpdateInfoClass, "convertedNanos", "J", false);
+		frameTimes.ConversionNanos = (int64)JEnv->GetLongField(Result, FrameUpdateInfo_conversionNanos);
+		frameTimes.FrameNumber = (int64)JEnv->GetLongField(Result, FrameUpdateInfo_frameNumber);
+		frameTimes.ExposureNanos = (int64)JEnv->GetLongField(Result, FrameUpdateInfo_exposureNanos);
+		frameTimes.ArrivalNanos = (int64)JEnv->GetLongField(Result, FrameUpdateInfo_arrivalNanos);
+		frameTimes.ConvertedNanos = (int64)JEnv->GetLongField(Result, FrameUpdateInfo_convertedNanos);
+		jfieldID FrameUpdateInfo_sensorFrames = FindField(JEnv, FrameUpdateInfoClass, "sensorFrames", "J", false);
+		jfieldID FrameUpdateInfo_imagesAcquired = FindField(JEnv, FrameUpdateInfoClass, "imagesAcquired", "J", false);
+		jfieldID FrameUpdateInfo_droppedDrain = FindField(JEnv, FrameUpdateInfoClass, "droppedDrain", "J", false);
+		jfieldID FrameUpdateInfo_droppedBusy = FindField(JEnv, FrameUpdateInfoClass, "droppedBusy", "J", false);
+		frameCounters.SensorFrames = (int64)JEnv->GetLongField(Result, FrameUpdateInfo_sensorFrames);
+		frameCounters.ImagesAcquired = (int64)JEnv->GetLongField(Result, FrameUpdateInfo_imagesAcquired);
+		frameCounters.DroppedDrain = (int64)JEnv->GetLongField(Result, FrameUpdateInfo_droppedDrain);
+		frameCounters.DroppedBusy = (int64)JEnv->GetLongField(Result, FrameUpdateInfo_droppedBusy);
 		return true;
 	}
 
@@ -5,6 +5,26 @@
 #include "CoreMinimal.h"
 #include "Android/AndroidJava.h"
 
+// Per-frame timing from Camera2UE.FrameUpdateInfo. Times are nanoseconds since the
+// Java object was created (elapsedRealtimeNanos base), like timeStamp.
+struct FAndroidCamera2JavaFrameTimes
+{
+	int64 FrameNumber = 0;
+	int64 ExposureNanos = 0;	// sensor start of exposure
+	int64 ArrivalNanos = 0;		// onYuvImage entry
+	int64 ConvertedNanos = 0;	// packtoI420Lib done
+	int64 ConversionNanos = 0;	// packtoI420Lib duration
+};
+
+// Session counters from Camera2UE, snapshotted when the frame is handed over.
+struct FAndroidCamera2JavaFrameCounters
+{
+	int64 SensorFrames = 0;		// onCaptureCompleted
+	int64 ImagesAcquired = 0;	// images taken from the ImageReader
+	int64 DroppedDrain = 0;		// older images closed by the listener drain loop
+	int64 DroppedBusy = 0;		// images skipped because C++ was reading FrameInfo
+};
+
 // Wrapper for com/FonseCode/Camera2UE.java.
 class FAndroidCamera2Java : public FJavaClassObject
 {
@@ -18,13 +38,19 @@ public:
 	bool GetInitilizedCamaraState();
 	void Release();
 	
-	// TODO: missing functionality for stillCapure
-    bool TakePhoto() ;
-    bool GetLastCapturedImage(TArray<uint8>& OutJpeg) const;
+	// Starts the AF/AE sequence and the still capture; the JPEG arrives later (GetLastJpegSequence).
+	bool TakePhoto();
+	// Sequence of the last still JPEG received, 0 if none yet. Does not lock: safe to poll every tick.
+	uint64 GetLastJpegSequence();
+	// Locks the Camera2UE direct buffer holding the last JPEG. OutJpeg points into it and is not
+	// overwritten (a new photo goes to the other buffer) until ReleaseLastJpeg. Any thread.
+	bool LockLastJpeg(const uint8*& OutJpeg, int32& OutSize, uint64& OutSequence);
+	void ReleaseLastJpeg();
+	// Copy of the last JPEG.
+	bool GetLastCapturedImage(TArray<uint8>& OutJpeg);
 	bool SaveResult(FString& OutAbsolutePath);
-	// END TODO
 
-	bool GetLastPreviewFrameInfo(void*& yPlaneBuffer, void*& uPlaneBuffer, void*& vPlaneBuffer, int32 & previewWidth, int32 & previewHeight, int64& timeStamp) ;    
+	bool GetLastPreviewFrameInfo(void*& yPlaneBuffer, void*& uPlaneBuffer, void*& vPlaneBuffer, int32 & previewWidth, int32 & previewHeight, int64& timeStamp, FAndroidCamera2JavaFrameTimes& frameTimes, FAndroidCamera2JavaFrameCounters& frameCounters) ;    
 	void ReleaseLastPreviewFrameInfo();	
 	int64 GetLastFrameTimeStamp();
 	bool GetCameraIntrinsincs(const FString& CameraId, float& FocalLengthX, float& FocalLengthY, float& PrincipalPointX, float& PrincipalPointY, float& Skew, int32& activeSensorLeft, int32& activeSensorTop, int32& activeSensorRight,  int32& activeSensorBottom, float& focalLengthMm, float& SensorWidthMM, float& SensorHeightMM, int32& sensorOrientation);
@@ -38,7 +64,9 @@ private:
 	FJavaClassMethod TakePhotoMethod;
 	FJavaClassMethod getLastFrameInfoMethod;
 	FJavaClassMethod releaseFrameInfoMethod;
-	FJavaClassMethod GetLastCapturedImageMethod;
+	FJavaClassMethod getLastJpegSequenceMethod;
+	FJavaClassMethod lockLastJpegMethod;
+	FJavaClassMethod releaseLastJpegMethod;
 	FJavaClassMethod SaveResultMethod;
 	FJavaClassMethod ReleaseMethod;
 	FJavaClassMethod getInitializeCameraStateMethod;
@@ -20,13 +20,15 @@ public class AndroidCamera2UECore : ModuleRules
             "Projects",   
 			"RenderCore",  
             "DeveloperSettings",
-            "MediaUtils"
+            "MediaUtils",
+            "ImageWrapper"
         });
 
 
         if (Target.Platform == UnrealTargetPlatform.Android)
         {
             PrivateDependencyModuleNames.Add("AndroidCamera2");
+            PrivateDependencyModuleNames.Add("libyuv");
         }
     }
 }
\ No newline at end of file
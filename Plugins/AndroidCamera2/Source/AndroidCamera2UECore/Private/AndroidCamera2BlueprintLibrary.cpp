@@ -22,6 +22,31 @@ bool UAndroidCamera2BlueprintLibrary::InitializeCamera(const FString& CameraId,
     return false;
 }
 
+bool UAndroidCamera2BlueprintLibrary::InitializeReplay(const FString& FilePath, EAndroidCamera2ReplayPacing Pacing, bool bLoop,
+    int32 RawWidth, int32 RawHeight, float RawFps)
+{
+    if (UGameInstance* GI = UGameplayStatics::GetGameInstance(GWorld))
+    {
+        if (auto* Cam2 = GI->GetSubsystem<UAndroidCamera2Subsystem>())
+        {
+            return Cam2->InitializeReplay(FilePath, Pacing, bLoop, RawWidth, RawHeight, RawFps);
+        }
+    }
+    return false;
+}
+
+bool UAndroidCamera2BlueprintLibrary::IsReplayFinished()
+{
+    if (UGameInstance* GI = UGameplayStatics::GetGameInstance(GWorld))
+    {
+        if (auto* Cam2 = GI->GetSubsystem<UAndroidCamera2Subsystem>())
+        {
+            return Cam2->IsReplayFinished();
+        }
+    }
+    return false;
+}
+
 void UAndroidCamera2BlueprintLibrary::ResumeCapturing()
 {
     if (UGameInstance* GI = UGameplayStatics::GetGameInstance(GWorld))
@@ -83,6 +108,172 @@ EAndroidCamera2State UAndroidCamera2BlueprintLibrary::GetCameraState()
     return EAndroidCamera2State::OFF;
 }
 
+FAndroidCamera2LatencyStats UAndroidCamera2BlueprintLibrary::GetLatencyStats(EAndroidCamera2LatencyStage Stage, float WindowSeconds)
+{
+    if (UGameInstance* GI = UGameplayStatics::GetGameInstance(GWorld))
+    {
+        if (auto* Cam2 = GI->GetSubsystem<UAndroidCamera2Subsystem>())
+        {
+            return Cam2->GetLatencyStats(Stage, WindowSeconds);
+        }
+    }
+
+    return FAndroidCamera2LatencyStats();
+}
+
+FAndroidCamera2FrameCounters UAndroidCamera2BlueprintLibrary::GetFrameCounters()
+{
+    if (UGameInstance* GI = UGameplayStatics::GetGameInstance(GWorld))
+    {
+        if (auto* Cam2 = GI->GetSubsystem<UAndroidCamera2Subsystem>())
+        {
+            return Cam2->GetFrameCounters();
+        }
+    }
+
+    return FAndroidCamera2FrameCounters();
+}
+
+bool UAndroidCamera2BlueprintLibrary::StartTelemetry(const FString& FileName)
+{
+    if (UGameInstance* GI = UGameplayStatics::GetGameInstance(GWorld))
+    {
+        if (auto* Cam2 = GI->GetSubsystem<UAndroidCamera2Subsystem>())
+        {
+            return Cam2->StartTelemetry(FileName);
+        }
+    }
+
+    return false;
+}
+
+void UAndroidCamera2BlueprintLibrary::StopTelemetry()
+{
+    if (UGameInstance* GI = UGameplayStatics::GetGameInstance(GWorld))
+    {
+        if (auto* Cam2 = GI->GetSubsystem<UAndroidCamera2Subsystem>())
+        {
+            Cam2->StopTelemetry();
+        }
+    }
+}
+
+bool UAndroidCamera2BlueprintLibrary::IsTelemetryRecording()
+{
+    if (UGameInstance* GI = UGameplayStatics::GetGameInstance(GWorld))
+    {
+        if (auto* Cam2 = GI->GetSubsystem<UAndroidCamera2Subsystem>())
+        {
+            return Cam2->IsTelemetryRecording();
+        }
+    }
+
+    return false;
+}
+
+bool UAndroidCamera2BlueprintLibrary::StartFrameRecording(const FString& FileName)
+{
+    if (UGameInstance* GI = UGameplayStatics::GetGameInstance(GWorld))
+    {
+        if (auto* Cam2 = GI->GetSubsystem<UAndroidCamera2Subsystem>())
+        {
+            return Cam2->StartFrameRecording(FileName);
+        }
+    }
+
+    return false;
+}
+
+void UAndroidCamera2BlueprintLibrary::StopFrameRecording()
+{
+    if (UGameInstance* GI = UGameplayStatics::GetGameInstance(GWorld))
+    {
+        if (auto* Cam2 = GI->GetSubsystem<UAndroidCamera2Subsystem>())
+        {
+            Cam2->StopFrameRecording();
+        }
+    }
+}
+
+FAndroidCamera2RecordingStats UAndroidCamera2BlueprintLibrary::GetFrameRecordingStats()
+{
+    if (UGameInstance* GI = UGameplayStatics::GetGameInstance(GWorld))
+    {
+        if (auto* Cam2 = GI->GetSubsystem<UAndroidCamera2Subsystem>())
+        {
+            return Cam2->GetFrameRecordingStats();
+        }
+    }
+
+    return FAndroidCamera2RecordingStats();
+}
+
+bool UAndroidCamera2BlueprintLibrary::TakePhoto(bool bCreateTexture)
+{
+    if (UGameInstance* GI = UGameplayStatics::GetGameInstance(GWorld))
+    {
+        if (auto* Cam2 = GI->GetSubsystem<UAndroidCamera2Subsystem>())
+        {
+            return Cam2->TakePhoto(bCreateTexture);
+        }
+    }
+
+    return false;
+}
+
+bool UAndroidCamera2BlueprintLibrary::IsPhotoPending()
+{
+    if (UGameInstance* GI = UGameplayStatics::GetGameInstance(GWorld))
+    {
+        if (auto* Cam2 = GI->GetSubsystem<UAndroidCamera2Subsystem>())
+        {
+            return Cam2->IsPhotoPending();
+        }
+    }
+
+    return false;
+}
+
+bool UAndroidCamera2BlueprintLibrary::CaptureZeroShutterLag(FAndroidCamera2Photo& OutPhoto, float SecondsAgo, int32 SharpestOfLast)
+{
+    OutPhoto = FAndroidCamera2Photo();
+    if (UGameInstance* GI = UGameplayStatics::GetGameInstance(GWorld))
+    {
+        if (auto* Cam2 = GI->GetSubsystem<UAndroidCamera2Subsystem>())
+        {
+            return Cam2->CaptureZeroShutterLag(OutPhoto, SecondsAgo, SharpestOfLast);
+        }
+    }
+
+    return false;
+}
+
+bool UAndroidCamera2BlueprintLibrary::SaveNextFrame(const FString& FileName, EAndroidCamera2ImageFormat Format, int32 Quality)
+{
+    if (UGameInstance* GI = UGameplayStatics::GetGameInstance(GWorld))
+    {
+        if (auto* Cam2 = GI->GetSubsystem<UAndroidCamera2Subsystem>())
+        {
+            return Cam2->SaveNextFrame(FileName, Format, Quality);
+        }
+    }
+
+    return false;
+}
+
+bool UAndroidCamera2BlueprintLibrary::SavePhoto(const FAndroidCamera2Photo& Photo, const FString& FileName, EAndroidCamera2ImageFormat Format, int32 Quality)
+{
+    if (UGameInstance* GI = UGameplayStatics::GetGameInstance(GWorld))
+    {
+        if (auto* Cam2 = GI->GetSubsystem<UAndroidCamera2Subsystem>())
+        {
+            return Cam2->SavePhoto(Photo, FileName, Format, Quality);
+        }
+    }
+
+    return false;
+}
+
 bool UAndroidCamera2BlueprintLibrary::GetCameraIntrinsics(FString CameraId, FAndroidCamera2Intrinsics& Intrinsics)
 {
 	Intrinsics = FAndroidCamera2Intrinsics();
@@ -118,3 +309,18 @@ FString UAndroidCamera2BlueprintLibrary::AndroidCamera2LensPose_ToString(const F
 {
     return In.ToString(); 
 }
+
+FString UAndroidCamera2BlueprintLibrary::AndroidCamera2FrameCounters_ToString(const FAndroidCamera2FrameCounters& In)
+{
+    return In.ToString();
+}
+
+FString UAndroidCamera2BlueprintLibrary::AndroidCamera2RecordingStats_ToString(const FAndroidCamera2RecordingStats& In)
+{
+    return In.ToString();
+}
+
+FString UAndroidCamera2BlueprintLibrary::AndroidCamera2Photo_ToString(const FAndroidCamera2Photo& In)
+{
+    return In.ToString();
+}
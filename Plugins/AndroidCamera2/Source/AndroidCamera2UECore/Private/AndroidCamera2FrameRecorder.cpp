@@ -0,0 +1,259 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+
+#include "AndroidCamera2FrameRecorder.h"
+#include "AndroidCamera2LosslessCodec.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/Event.h"
+#include "Misc/Paths.h"
+
+FAndroidCamera2FrameRecorder::~FAndroidCamera2FrameRecorder()
+{
+	StopRecording();
+}
+
+bool FAndroidCamera2FrameRecorder::StartRecording(const FString& InFilePath, int32 FramesPerSecond, int32 QueueDepth, EAndroidCamera2RecordingFormat InFormat)
+{
+	StopRecording();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(InFilePath));
+	File.Reset(PlatformFile.OpenWrite(*InFilePath));
+	if (!File)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FAndroidCamera2FrameRecorder::StartRecording::No se pudo abrir %s"), *InFilePath);
+		return false;
+	}
+
+	FilePath = InFilePath;
+	Fps = FMath::Max(1, FramesPerSecond);
+	Format = InFormat;
+	if (Format == EAndroidCamera2RecordingFormat::Lossless && !Codec)
+	{
+		Codec = MakeUnique<FAndroidCamera2LosslessCodec>();
+	}
+
+	// Los buffers se reservan con el primer frame; el array exterior no se realoja nunca.
+	NumBuffers = FMath::Max(2, QueueDepth);
+	Buffers.Reset();
+	Buffers.SetNum(NumBuffers);
+	FreeBuffers.Empty();
+	QueuedFrames.Empty();
+	for (int32 i = 0; i < NumBuffers; ++i)
+	{
+		FreeBuffers.Enqueue(i);
+	}
+
+	FrameWidth = FrameHeight = 0;
+	bHeaderWritten = false;
+	bWarnedSizeChange = false;
+	RecordedFrames = 0;
+	DroppedFrames = 0;
+	InFlight = 0;
+	BytesWritten = 0;
+	RawBytes = 0;
+	EncodedFrames = 0;
+	EncodeCycles = 0;
+
+	bStopRequested = false;
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("AndroidCamera2FrameRecorder"), 0, TPri_BelowNormal);
+	if (!Thread)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		WakeEvent = nullptr;
+		File.Reset();
+		return false;
+	}
+	bRecording = true;
+
+	UE_LOG(LogTemp, Log, TEXT("FAndroidCamera2FrameRecorder::StartRecording::%s"), *FilePath);
+	return true;
+}
+
+void FAndroidCamera2FrameRecorder::StopRecording()
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	bRecording = false;
+	Stop();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+	File.Reset();
+
+	// Libera la memoria del pool; el próximo StartRecording la vuelve a reservar.
+	FreeBuffers.Empty();
+	Buffers.Empty();
+
+	UE_LOG(LogTemp, Log, TEXT("FAndroidCamera2FrameRecorder::StopRecording::%lld frames grabados, %lld descartados, codificación %.2f ms/frame, %s"),
+		RecordedFrames.load(), DroppedFrames.load(), GetStats().EncodeMs, *FilePath);
+}
+
+void FAndroidCamera2FrameRecorder::Stop()
+{
+	bStopRequested = true;
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+bool FAndroidCamera2FrameRecorder::PushFrame(const uint8* Y, const uint8* U, const uint8* V, int32 Width, int32 Height, uint64 Sequence, int64 TimestampUs)
+{
+	if (!IsRecording() || !Y || !U || !V || Width <= 0 || Height <= 0)
+	{
+		return false;
+	}
+
+	if (FrameWidth == 0)
+	{
+		FrameWidth = Width;
+		FrameHeight = Height;
+	}
+	else if (Width != FrameWidth || Height != FrameHeight)
+	{
+		// Y4M no admite cambios de tamaño dentro del fichero.
+		if (!bWarnedSizeChange)
+		{
+			bWarnedSizeChange = true;
+			UE_LOG(LogTemp, Warning, TEXT("FAndroidCamera2FrameRecorder::PushFrame::El tamaño cambió de %dx%d a %dx%d, frames descartados"), FrameWidth, FrameHeight, Width, Height);
+		}
+		DroppedFrames.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	int32 Index = INDEX_NONE;
+	if (!FreeBuffers.Dequeue(Index))
+	{
+		// Backpressure: el disco no da abasto, mejor perder el frame que bloquear TickFetch.
+		DroppedFrames.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	const int32 BytesY = Width * Height;
+	const int32 BytesUV = (Width / 2) * (Height / 2);
+	TArray<uint8>& Buffer = Buffers[Index];
+	Buffer.SetNumUninitialized(BytesY + 2 * BytesUV, EAllowShrinking::No);
+	FMemory::Memcpy(Buffer.GetData(), Y, BytesY);
+	FMemory::Memcpy(Buffer.GetData() + BytesY, U, BytesUV);
+	FMemory::Memcpy(Buffer.GetData() + BytesY + BytesUV, V, BytesUV);
+
+	FQueuedFrame Frame;
+	Frame.Buffer = Index;
+	Frame.Sequence = Sequence;
+	Frame.TimestampUs = TimestampUs;
+	InFlight.fetch_add(1, std::memory_order_relaxed);
+	QueuedFrames.Enqueue(Frame);
+	WakeEvent->Trigger();
+	return true;
+}
+
+FAndroidCamera2RecordingStats FAndroidCamera2FrameRecorder::GetStats() const
+{
+	FAndroidCamera2RecordingStats Stats;
+	Stats.bRecording = IsRecording();
+	Stats.RecordedFrames = RecordedFrames.load(std::memory_order_relaxed);
+	Stats.DroppedFrames = DroppedFrames.load(std::memory_order_relaxed);
+	Stats.QueuedFrames = InFlight.load(std::memory_order_relaxed);
+	Stats.BytesWritten = BytesWritten.load(std::memory_order_relaxed);
+	const int64 Raw = RawBytes.load(std::memory_order_relaxed);
+	Stats.CompressionRatio = Stats.BytesWritten > 0 && Raw > 0 ? static_cast<float>(static_cast<double>(Raw) / Stats.BytesWritten) : 1.f;
+	const int64 Encoded = EncodedFrames.load(std::memory_order_relaxed);
+	Stats.EncodeMs = Encoded > 0 ? static_cast<float>(FPlatformTime::ToMilliseconds64(EncodeCycles.load(std::memory_order_relaxed)) / Encoded) : 0.f;
+	Stats.FilePath = FilePath;
+	return Stats;
+}
+
+uint32 FAndroidCamera2FrameRecorder::Run()
+{
+	while (!bStopRequested)
+	{
+		WakeEvent->Wait(100);
+		WriteQueuedFrames();
+	}
+	WriteQueuedFrames();
+	File->Flush();
+	return 0;
+}
+
+void FAndroidCamera2FrameRecorder::WriteQueuedFrames()
+{
+	FQueuedFrame Frame;
+	while (QueuedFrames.Dequeue(Frame))
+	{
+		int64 Bytes = 0;
+		if (WriteFrame(Frame, Bytes))
+		{
+			RecordedFrames.fetch_add(1, std::memory_order_relaxed);
+			BytesWritten.fetch_add(Bytes, std::memory_order_relaxed);
+			RawBytes.fetch_add(Buffers[Frame.Buffer].Num(), std::memory_order_relaxed);
+		}
+		else
+		{
+			DroppedFrames.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		InFlight.fetch_sub(1, std::memory_order_relaxed);
+		FreeBuffers.Enqueue(Frame.Buffer);
+	}
+}
+
+bool FAndroidCamera2FrameRecorder::WriteFrame(const FQueuedFrame& Frame, int64& OutBytes)
+{
+	const TArray<uint8>& Buffer = Buffers[Frame.Buffer];
+	OutBytes = 0;
+
+	if (Format == EAndroidCamera2RecordingFormat::Lossless)
+	{
+		if (!bHeaderWritten)
+		{
+			FAndroidCamera2LosslessCodec::FFileHeader Header;
+			Header.Width = FrameWidth;
+			Header.Height = FrameHeight;
+			Header.FpsMilli = Fps * 1000;
+			File->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+			OutBytes += sizeof(Header);
+			bHeaderWritten = true;
+		}
+
+		const uint64 EncodeStart = FPlatformTime::Cycles64();
+		Codec->Encode(Buffer.GetData(), FrameWidth, FrameHeight, Payload);
+		EncodeCycles.fetch_add(FPlatformTime::Cycles64() - EncodeStart, std::memory_order_relaxed);
+		EncodedFrames.fetch_add(1, std::memory_order_relaxed);
+
+		FAndroidCamera2LosslessCodec::FFrameHeader FrameHeader;
+		FrameHeader.PayloadSize = Payload.Num();
+		FrameHeader.Sequence = Frame.Sequence;
+		FrameHeader.TimestampUs = Frame.TimestampUs;
+		OutBytes += sizeof(FrameHeader) + Payload.Num();
+		return File->Write(reinterpret_cast<const uint8*>(&FrameHeader), sizeof(FrameHeader))
+			&& File->Write(Payload.GetData(), Payload.Num());
+	}
+
+	if (!bHeaderWritten)
+	{
+		// FrameWidth/FrameHeight se fijan en el GameThread antes de encolar el primer frame.
+		const FString Header = FString::Printf(TEXT("YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n"), FrameWidth, FrameHeight, Fps);
+		const FTCHARToUTF8 HeaderUtf8(*Header);
+		File->Write(reinterpret_cast<const uint8*>(HeaderUtf8.Get()), HeaderUtf8.Length());
+		OutBytes += HeaderUtf8.Length();
+		bHeaderWritten = true;
+	}
+
+	ANSICHAR FrameHeader[96];
+	const int32 HeaderLen = FCStringAnsi::Snprintf(FrameHeader, sizeof(FrameHeader), "FRAME XSEQ=%llu XTS=%lld\n",
+		static_cast<unsigned long long>(Frame.Sequence), static_cast<long long>(Frame.TimestampUs));
+	OutBytes += HeaderLen + Buffer.Num();
+	return HeaderLen > 0
+		&& File->Write(reinterpret_cast<const uint8*>(FrameHeader), HeaderLen)
+		&& File->Write(Buffer.GetData(), Buffer.Num());
+}
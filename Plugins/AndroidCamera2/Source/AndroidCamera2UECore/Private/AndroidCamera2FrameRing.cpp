@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+
+#include "AndroidCamera2FrameRing.h"
+#include "AndroidCamera2Photo.h"
+
+void FAndroidCamera2FrameRing::Configure(int32 InCapacity)
+{
+	Slots.Empty(FMath::Max(0, InCapacity));
+	Slots.SetNum(FMath::Max(0, InCapacity));
+	Reset();
+}
+
+void FAndroidCamera2FrameRing::Reset()
+{
+	Head = 0;
+	Count = 0;
+}
+
+void FAndroidCamera2FrameRing::Push(const uint8* Y, const uint8* U, const uint8* V, int32 Width, int32 Height, uint64 Sequence, uint64 TimestampCycles64)
+{
+	if (Slots.Num() == 0 || !Y || !U || !V || Width <= 0 || Height <= 0)
+		return;
+
+	FSlot& Slot = Slots[Head];
+	const int64 BytesY = static_cast<int64>(Width) * Height;
+	const int64 BytesUV = static_cast<int64>(Width / 2) * (Height / 2);
+	Slot.I420.SetNumUninitialized(BytesY + 2 * BytesUV, EAllowShrinking::No);
+	FMemory::Memcpy(Slot.I420.GetData(), Y, BytesY);
+	FMemory::Memcpy(Slot.I420.GetData() + BytesY, U, BytesUV);
+	FMemory::Memcpy(Slot.I420.GetData() + BytesY + BytesUV, V, BytesUV);
+	Slot.Width = Width;
+	Slot.Height = Height;
+	Slot.Sequence = Sequence;
+	Slot.TimestampCycles64 = TimestampCycles64;
+
+	Head = (Head + 1) % Slots.Num();
+	Count = FMath::Min(Count + 1, Slots.Num());
+}
+
+uint64 FAndroidCamera2FrameRing::Sharpness(const FSlot& Slot)
+{
+	const uint8* Luma = Slot.I420.GetData();
+	const int32 W = Slot.Width;
+	uint64 Energy = 0;
+	for (int32 y = 0; y + 2 < Slot.Height; y += 2)
+	{
+		const uint8* Row = Luma + static_cast<int64>(y) * W;
+		const uint8* Down = Row + 2 * static_cast<int64>(W);
+		uint32 RowEnergy = 0; // <= (W/2) * 2 * 255^2: cabe en 32 bits hasta 65k de ancho
+		for (int32 x = 0; x + 2 < W; x += 2)
+		{
+			const int32 Dx = Row[x + 2] - Row[x];
+			const int32 Dy = Down[x] - Row[x];
+			RowEnergy += static_cast<uint32>(Dx * Dx + Dy * Dy);
+		}
+		Energy += RowEnergy;
+	}
+	return Energy;
+}
+
+bool FAndroidCamera2FrameRing::Capture(uint64 RequestCycles64, int32 SharpestOfLast, FAndroidCamera2Photo& OutPhoto) const
+{
+	if (Count == 0)
+		return false;
+
+	// Más cercano al instante pedido (Age 0 = el más reciente)
+	int32 BestAge = 0;
+	uint64 BestDistance = MAX_uint64;
+	for (int32 Age = 0; Age < Count; ++Age)
+	{
+		const uint64 Timestamp = GetSlot(Age).TimestampCycles64;
+		const uint64 Distance = Timestamp > RequestCycles64 ? Timestamp - RequestCycles64 : RequestCycles64 - Timestamp;
+		if (Distance < BestDistance)
+		{
+			BestDistance = Distance;
+			BestAge = Age;
+		}
+	}
+
+	// Más nítido entre ese y los anteriores (mismo tamaño: la comparación de energías vale)
+	if (SharpestOfLast > 1)
+	{
+		const FSlot& Nearest = GetSlot(BestAge);
+		const int32 LastAge = FMath::Min(Count, BestAge + SharpestOfLast) - 1;
+		uint64 BestSharpness = Sharpness(Nearest);
+		for (int32 Age = BestAge + 1; Age <= LastAge; ++Age)
+		{
+			const FSlot& Candidate = GetSlot(Age);
+			if (Candidate.Width != Nearest.Width || Candidate.Height != Nearest.Height)
+				break;
+
+			const uint64 CandidateSharpness = Sharpness(Candidate);
+			if (CandidateSharpness > BestSharpness)
+			{
+				BestSharpness = CandidateSharpness;
+				BestAge = Age;
+			}
+		}
+	}
+
+	const FSlot& Slot = GetSlot(BestAge);
+	const int64 BytesY = static_cast<int64>(Slot.Width) * Slot.Height;
+	const int64 BytesUV = static_cast<int64>(Slot.Width / 2) * (Slot.Height / 2);
+	OutPhoto = FAndroidCamera2Photo();
+	OutPhoto.bValid = true;
+	OutPhoto.Width = Slot.Width;
+	OutPhoto.Height = Slot.Height;
+	OutPhoto.Sequence = static_cast<int64>(Slot.Sequence);
+	OutPhoto.Y.Append(Slot.I420.GetData(), BytesY);
+	OutPhoto.U.Append(Slot.I420.GetData() + BytesY, BytesUV);
+	OutPhoto.V.Append(Slot.I420.GetData() + BytesY + BytesUV, BytesUV);
+	return true;
+}
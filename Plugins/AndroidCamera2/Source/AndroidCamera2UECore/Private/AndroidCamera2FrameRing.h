@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAndroidCamera2Photo;
+
+/**
+ * Anillo de los últimos N frames I420 de preview para captura sin retardo (zero shutter lag).
+ * Cada hueco reserva su memoria una vez y se reutiliza; solo se realoca si cambia el tamaño.
+ * Capture devuelve al instante el frame más cercano a la marca de tiempo pedida, o el más
+ * nítido de los K anteriores a ese, sin pedir nada al sensor. Solo GameThread.
+ */
+class FAndroidCamera2FrameRing
+{
+public:
+	/** Capacidad en frames; 0 desactiva el anillo y libera la memoria. */
+	void Configure(int32 InCapacity);
+
+	bool IsEnabled() const { return Slots.Num() > 0; }
+	int32 Num() const { return Count; }
+
+	/** Copia los planos (Y Width x Height, U y V Width/2 x Height/2, compactos) sobre el hueco más antiguo. */
+	void Push(const uint8* Y, const uint8* U, const uint8* V, int32 Width, int32 Height, uint64 Sequence, uint64 TimestampCycles64);
+
+	/** Olvida los frames guardados (la memoria se conserva). */
+	void Reset();
+
+	/**
+	 * @param RequestCycles64 Instante pedido (Cycles64, como los timestamps de los frames)
+	 * @param SharpestOfLast  > 1: elegir el más nítido entre el más cercano y los K-1 anteriores
+	 */
+	bool Capture(uint64 RequestCycles64, int32 SharpestOfLast, FAndroidCamera2Photo& OutPhoto) const;
+
+private:
+	struct FSlot
+	{
+		TArray<uint8> I420;
+		int32 Width = 0;
+		int32 Height = 0;
+		uint64 Sequence = 0;
+		uint64 TimestampCycles64 = 0;
+	};
+
+	/** Energía del gradiente de la luminancia, muestreada cada 2 píxeles: mayor = más nítido. */
+	static uint64 Sharpness(const FSlot& Slot);
+
+	const FSlot& GetSlot(int32 Age) const { return Slots[(Head - 1 - Age + Slots.Num()) % Slots.Num()]; }
+
+	TArray<FSlot> Slots;
+	int32 Head = 0;		// siguiente hueco a escribir
+	int32 Count = 0;
+};
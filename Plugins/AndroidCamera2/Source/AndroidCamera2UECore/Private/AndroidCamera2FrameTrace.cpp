@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+
+#include "AndroidCamera2FrameTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(AndroidCamera2Channel);
+
+UE_TRACE_EVENT_BEGIN(AndroidCamera2, FrameStage)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, Sequence)
+	UE_TRACE_EVENT_FIELD(uint8, Stage)
+UE_TRACE_EVENT_END()
+
+void FAndroidCamera2FrameTimes::Mark(EAndroidCamera2FrameStage Stage, uint64 InCycles)
+{
+	Cycles[static_cast<int32>(Stage)] = InCycles;
+
+	// Con el canal apagado (o sin trace compilado) sólo cuesta una comprobación.
+	UE_TRACE_LOG(AndroidCamera2, FrameStage, AndroidCamera2Channel)
+		<< FrameStage.Cycle(InCycles)
+		<< FrameStage.Sequence(Sequence)
+		<< FrameStage.Stage(static_cast<uint8>(Stage));
+}
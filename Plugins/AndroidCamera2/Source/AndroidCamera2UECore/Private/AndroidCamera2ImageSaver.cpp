@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+
+#include "AndroidCamera2ImageSaver.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+
+#if PLATFORM_ANDROID
+THIRD_PARTY_INCLUDES_START
+#include "libyuv/convert_argb.h"
+THIRD_PARTY_INCLUDES_END
+#endif
+
+void FAndroidCamera2ImageSaver::Configure(int32 InMaxInFlight)
+{
+	check(GetInFlight() == 0);
+	ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>("ImageWrapper");
+
+	Slots.Reset();
+	Slots.SetNum(FMath::Max(1, InMaxInFlight));
+	FreeSlots.Empty();
+	for (int32 i = 0; i < Slots.Num(); ++i)
+	{
+		FreeSlots.Enqueue(i);
+	}
+}
+
+bool FAndroidCamera2ImageSaver::Save(const uint8* Y, const uint8* U, const uint8* V, int32 Width, int32 Height,
+	const FString& FilePath, EAndroidCamera2ImageFormat Format, int32 Quality, FOnSaved OnSaved)
+{
+	int32 SlotIndex = INDEX_NONE;
+	if (!Y || !U || !V || Width < 2 || Height < 2 || ((Width | Height) & 1) || !FreeSlots.Dequeue(SlotIndex))
+	{
+		return false;
+	}
+	++InFlight;
+
+	FSlot& Slot = Slots[SlotIndex];
+	const int64 BytesY = static_cast<int64>(Width) * Height;
+	const int64 BytesUV = static_cast<int64>(Width / 2) * (Height / 2);
+	Slot.I420.SetNumUninitialized(BytesY + 2 * BytesUV, EAllowShrinking::No);
+	FMemory::Memcpy(Slot.I420.GetData(), Y, BytesY);
+	FMemory::Memcpy(Slot.I420.GetData() + BytesY, U, BytesUV);
+	FMemory::Memcpy(Slot.I420.GetData() + BytesY + BytesUV, V, BytesUV);
+
+	// La tarea retiene el saver: puede terminar después de que el subsistema se destruya.
+	TSharedRef<FAndroidCamera2ImageSaver, ESPMode::ThreadSafe> This = AsShared();
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [This, SlotIndex, Width, Height, FilePath, Format, Quality, OnSaved = MoveTemp(OnSaved)]() mutable
+	{
+		const bool bOk = This->Encode(This->Slots[SlotIndex], Width, Height, FilePath, Format, Quality);
+		This->FreeSlots.Enqueue(SlotIndex);
+		--This->InFlight;
+
+		if (OnSaved)
+		{
+			AsyncTask(ENamedThreads::GameThread, [bOk, FilePath, OnSaved = MoveTemp(OnSaved)]()
+			{
+				OnSaved(bOk, FilePath);
+			});
+		}
+	});
+	return true;
+}
+
+bool FAndroidCamera2ImageSaver::Encode(FSlot& Slot, int32 Width, int32 Height, const FString& FilePath, EAndroidCamera2ImageFormat Format, int32 Quality) const
+{
+	const uint8* Y = Slot.I420.GetData();
+	const uint8* U = Y + static_cast<int64>(Width) * Height;
+	const uint8* V = U + static_cast<int64>(Width / 2) * (Height / 2);
+	Slot.BGRA.SetNumUninitialized(static_cast<int64>(Width) * Height * 4, EAllowShrinking::No);
+
+#if PLATFORM_ANDROID
+	// libyuv "ARGB" es BGRA en memoria
+	libyuv::I420ToARGB(Y, Width, U, Width / 2, V, Width / 2, Slot.BGRA.GetData(), Width * 4, Width, Height);
+#else
+	// Sin libyuv: BT.601 rango limitado, como libyuv
+	for (int32 y = 0; y < Height; ++y)
+	{
+		const uint8* RowY = Y + static_cast<int64>(y) * Width;
+		const uint8* RowU = U + static_cast<int64>(y / 2) * (Width / 2);
+		const uint8* RowV = V + static_cast<int64>(y / 2) * (Width / 2);
+		uint8* Out = Slot.BGRA.GetData() + static_cast<int64>(y) * Width * 4;
+		for (int32 x = 0; x < Width; ++x)
+		{
+			const int32 C = 298 * (RowY[x] - 16);
+			const int32 D = RowU[x / 2] - 128;
+			const int32 E = RowV[x / 2] - 128;
+			Out[x * 4 + 0] = static_cast<uint8>(FMath::Clamp((C + 516 * D + 128) >> 8, 0, 255));
+			Out[x * 4 + 1] = static_cast<uint8>(FMath::Clamp((C - 100 * D - 208 * E + 128) >> 8, 0, 255));
+			Out[x * 4 + 2] = static_cast<uint8>(FMath::Clamp((C + 409 * E + 128) >> 8, 0, 255));
+			Out[x * 4 + 3] = 255;
+		}
+	}
+#endif
+
+	TSharedPtr<IImageWrapper> Wrapper = ImageWrapperModule->CreateImageWrapper(Format == EAndroidCamera2ImageFormat::PNG ? EImageFormat::PNG : EImageFormat::JPEG);
+	if (!Wrapper.IsValid() || !Wrapper->SetRaw(Slot.BGRA.GetData(), Slot.BGRA.Num(), Width, Height, ERGBFormat::BGRA, 8))
+	{
+		return false;
+	}
+
+	// PNG: 0 = compresión por defecto; JPEG: calidad 1-100
+	const TArray64<uint8> Compressed = Wrapper->GetCompressed(Format == EAndroidCamera2ImageFormat::PNG ? 0 : FMath::Clamp(Quality, 1, 100));
+	if (Compressed.Num() == 0)
+	{
+		return false;
+	}
+
+	FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*FPaths::GetPath(FilePath));
+	if (!FFileHelper::SaveArrayToFile(Compressed, *FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FAndroidCamera2ImageSaver::Encode::No se pudo escribir %s"), *FilePath);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "AndroidCamera2Photo.h"
+#include <atomic>
+
+class IImageWrapperModule;
+
+/**
+ * Guarda frames I420 como PNG/JPEG en tareas de fondo: I420 -> BGRA (libyuv en Android),
+ * codificación con IImageWrapper y escritura del fichero, sin tocar el GameThread.
+ *
+ * Como mucho MaxInFlight imágenes a la vez; cada una usa un hueco del pool (I420 + BGRA)
+ * reservado con la primera imagen y reutilizado después. Con el pool lleno Save devuelve
+ * false y no copia nada, así una ráfaga nunca bloquea ni acumula memoria.
+ */
+class FAndroidCamera2ImageSaver : public TSharedFromThis<FAndroidCamera2ImageSaver, ESPMode::ThreadSafe>
+{
+public:
+	using FOnSaved = TFunction<void(bool bSuccess, const FString& FilePath)>;
+
+	/** Dimensiona el pool y carga ImageWrapper. GameThread, sin guardados en curso. */
+	void Configure(int32 InMaxInFlight);
+
+	/** true si caben Reserved + 1 guardados más. */
+	bool CanSave(int32 Reserved = 0) const { return InFlight.load(std::memory_order_relaxed) + Reserved < Slots.Num(); }
+	int32 GetInFlight() const { return InFlight.load(std::memory_order_relaxed); }
+
+	/**
+	 * Copia los planos (Y Width x Height, U y V Width/2 x Height/2, compactos; tamaño par) y lanza
+	 * la tarea. OnSaved se llama en el GameThread. GameThread.
+	 */
+	bool Save(const uint8* Y, const uint8* U, const uint8* V, int32 Width, int32 Height,
+		const FString& FilePath, EAndroidCamera2ImageFormat Format, int32 Quality, FOnSaved OnSaved);
+
+private:
+	struct FSlot
+	{
+		TArray<uint8> I420;
+		TArray64<uint8> BGRA;
+	};
+
+	bool Encode(FSlot& Slot, int32 Width, int32 Height, const FString& FilePath, EAndroidCamera2ImageFormat Format, int32 Quality) const;
+
+	TArray<FSlot> Slots;
+	TQueue<int32, EQueueMode::Mpsc> FreeSlots;	// las tareas devuelven, el GameThread toma
+	std::atomic<int32> InFlight{ 0 };
+	IImageWrapperModule* ImageWrapperModule = nullptr;
+};
@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+
+#include "AndroidCamera2LatencyHistogram.h"
+
+namespace AndroidCamera2Latency
+{
+	static constexpr uint32 MaxMicros = (1u << (FAndroidCamera2LatencyHistogram::MaxExponent + 1)) - 1;
+	static constexpr int32 MaxSlices = 64;
+}
+
+FAndroidCamera2LatencyHistogram::FSlice::FSlice()
+{
+	Clear();
+}
+
+void FAndroidCamera2LatencyHistogram::FSlice::Clear()
+{
+	for (std::atomic<uint32>& Count : Counts)
+	{
+		Count.store(0, std::memory_order_relaxed);
+	}
+	MaxMicros.store(0, std::memory_order_relaxed);
+	Spikes.store(0, std::memory_order_relaxed);
+}
+
+FAndroidCamera2LatencyHistogram::FAndroidCamera2LatencyHistogram(double InWindowSeconds, int32 InNumSlices)
+{
+	Configure(InWindowSeconds, InNumSlices);
+}
+
+void FAndroidCamera2LatencyHistogram::Configure(double InWindowSeconds, int32 InNumSlices)
+{
+	WindowSeconds = FMath::Max(0.01, InWindowSeconds);
+	NumSlices = FMath::Clamp(InNumSlices, 1, AndroidCamera2Latency::MaxSlices);
+	SliceCycles = FMath::Max<uint64>(1, FPlatformTime::SecondsToCycles64(WindowSeconds / NumSlices));
+	Slices = MakeUnique<FSlice[]>(NumSlices);
+}
+
+void FAndroidCamera2LatencyHistogram::Reset()
+{
+	for (int32 i = 0; i < NumSlices; ++i)
+	{
+		Slices[i].Epoch.store(MAX_uint64, std::memory_order_relaxed);
+		Slices[i].Clear();
+	}
+}
+
+int32 FAndroidCamera2LatencyHistogram::BucketIndex(uint32 Micros)
+{
+	Micros = FMath::Min(Micros, AndroidCamera2Latency::MaxMicros);
+	if (Micros < SubBuckets)
+	{
+		return static_cast<int32>(Micros);
+	}
+
+	const int32 Exponent = static_cast<int32>(FMath::FloorLog2(Micros));
+	const int32 Shift = Exponent - SubBucketBits;
+	return (Shift + 1) * SubBuckets + static_cast<int32>((Micros >> Shift) & (SubBuckets - 1));
+}
+
+uint32 FAndroidCamera2LatencyHistogram::BucketLowerMicros(int32 Index)
+{
+	if (Index < SubBuckets)
+	{
+		return static_cast<uint32>(Index);
+	}
+
+	const int32 Shift = Index / SubBuckets - 1;
+	return static_cast<uint32>(SubBuckets + Index % SubBuckets) << Shift;
+}
+
+uint32 FAndroidCamera2LatencyHistogram::BucketUpperMicros(int32 Index)
+{
+	const int32 Shift = (Index < SubBuckets) ? 0 : Index / SubBuckets - 1;
+	return BucketLowerMicros(Index) + (1u << Shift);
+}
+
+uint64 FAndroidCamera2LatencyHistogram::NowEpoch() const
+{
+	return FPlatformTime::Cycles64() / SliceCycles;
+}
+
+void FAndroidCamera2LatencyHistogram::AddSampleCycles(uint64 Cycles)
+{
+	AddSample(FPlatformTime::ToMilliseconds64(Cycles));
+}
+
+void FAndroidCamera2LatencyHistogram::AddSample(double Milliseconds)
+{
+	const uint32 Micros = static_cast<uint32>(FMath::Clamp(Milliseconds * 1000.0, 0.0, static_cast<double>(AndroidCamera2Latency::MaxMicros)));
+
+	const uint64 Epoch = NowEpoch();
+	FSlice& Slice = Slices[Epoch % NumSlices];
+
+	// El primer hilo que llega a un slice caducado lo recicla.
+	uint64 SliceEpoch = Slice.Epoch.load(std::memory_order_acquire);
+	if (SliceEpoch != Epoch)
+	{
+		if (SliceEpoch > Epoch && SliceEpoch != MAX_uint64)
+		{
+			// Slice ya reciclado por un tiempo posterior: muestra demasiado antigua.
+			return;
+		}
+		if (Slice.Epoch.compare_exchange_strong(SliceEpoch, Epoch, std::memory_order_acq_rel))
+		{
+			Slice.Clear();
+		}
+	}
+
+	Slice.Counts[BucketIndex(Micros)].fetch_add(1, std::memory_order_relaxed);
+	if (Milliseconds * 1000.0 > SpikeMicros)
+	{
+		Slice.Spikes.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	uint32 Max = Slice.MaxMicros.load(std::memory_order_relaxed);
+	while (Micros > Max && !Slice.MaxMicros.compare_exchange_weak(Max, Micros, std::memory_order_relaxed))
+	{
+	}
+}
+
+int32 FAndroidCamera2LatencyHistogram::SumWindow(double InWindowSeconds, uint32* OutCounts, uint32& OutMaxMicros, uint32* OutSpikes) const
+{
+	int32 WindowSlices = NumSlices;
+	if (InWindowSeconds > 0.0)
+	{
+		WindowSlices = FMath::Clamp(FMath::CeilToInt32(InWindowSeconds * NumSlices / WindowSeconds), 1, NumSlices);
+	}
+
+	FMemory::Memzero(OutCounts, sizeof(uint32) * NumBuckets);
+	OutMaxMicros = 0;
+	if (OutSpikes)
+	{
+		*OutSpikes = 0;
+	}
+
+	const uint64 Now = NowEpoch();
+	int32 Total = 0;
+	for (int32 i = 0; i < NumSlices; ++i)
+	{
+		const FSlice& Slice = Slices[i];
+		const uint64 Epoch = Slice.Epoch.load(std::memory_order_acquire);
+		if (Epoch > Now || Now - Epoch >= static_cast<uint64>(WindowSlices))
+		{
+			continue;
+		}
+
+		for (int32 b = 0; b < NumBuckets; ++b)
+		{
+			const uint32 Count = Slice.Counts[b].load(std::memory_order_relaxed);
+			OutCounts[b] += Count;
+			Total += Count;
+		}
+		OutMaxMicros = FMath::Max(OutMaxMicros, Slice.MaxMicros.load(std::memory_order_relaxed));
+		if (OutSpikes)
+		{
+			*OutSpikes += Slice.Spikes.load(std::memory_order_relaxed);
+		}
+	}
+	return Total;
+}
+
+FAndroidCamera2LatencyStats FAndroidCamera2LatencyHistogram::GetStats(double InWindowSeconds) const
+{
+	FAndroidCamera2LatencyStats Stats;
+
+	uint32 Counts[NumBuckets];
+	uint32 MaxMicros = 0;
+	const int32 Total = SumWindow(InWindowSeconds, Counts, MaxMicros);
+	if (Total <= 0)
+	{
+		return Stats;
+	}
+
+	const double Percentiles[3] = { 0.50, 0.95, 0.99 };
+	float* Outputs[3] = { &Stats.P50Ms, &Stats.P95Ms, &Stats.P99Ms };
+
+	int32 Next = 0;
+	int64 Cumulative = 0;
+	for (int32 b = 0; b < NumBuckets && Next < 3; ++b)
+	{
+		Cumulative += Counts[b];
+		while (Next < 3 && Cumulative >= FMath::CeilToInt64(Percentiles[Next] * Total))
+		{
+			*Outputs[Next] = FMath::Min(BucketUpperMicros(b), MaxMicros) * 1e-3f;
+			++Next;
+		}
+	}
+
+	Stats.MaxMs = MaxMicros * 1e-3f;
+	Stats.NumSamples = Total;
+	return Stats;
+}
+
+float FAndroidCamera2LatencyHistogram::GetFractionAbove(double Milliseconds, double InWindowSeconds) const
+{
+	uint32 Counts[NumBuckets];
+	uint32 MaxMicros = 0;
+	const int32 Total = SumWindow(InWindowSeconds, Counts, MaxMicros);
+	if (Total <= 0)
+	{
+		return 0.f;
+	}
+
+	// Cuenta los buckets que empiezan por encima del umbral.
+	const uint32 Threshold = static_cast<uint32>(FMath::Clamp(Milliseconds * 1000.0, 0.0, static_cast<double>(AndroidCamera2Latency::MaxMicros)));
+	int32 Above = 0;
+	for (int32 b = BucketIndex(Threshold) + 1; b < NumBuckets; ++b)
+	{
+		Above += Counts[b];
+	}
+	return static_cast<float>(Above) / Total;
+}
+
+void FAndroidCamera2LatencyHistogram::SetSpikeThreshold(double Milliseconds)
+{
+	SpikeMicros = static_cast<uint32>(FMath::Clamp(Milliseconds * 1000.0, 0.0, static_cast<double>(AndroidCamera2Latency::MaxMicros)));
+}
+
+float FAndroidCamera2LatencyHistogram::GetSpikeFraction(double InWindowSeconds) const
+{
+	if (SpikeMicros == MAX_uint32)
+	{
+		return 0.f;
+	}
+
+	uint32 Counts[NumBuckets];
+	uint32 MaxMicros = 0;
+	uint32 Spikes = 0;
+	const int32 Total = SumWindow(InWindowSeconds, Counts, MaxMicros, &Spikes);
+	return Total > 0 ? static_cast<float>(Spikes) / Total : 0.f;
+}
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Lossless I420 frame codec used by the frame recorder and the replay source (.ac2l).
+ *
+ * Each plane is cut into strips of BlockRows rows. Every strip is predicted on its own
+ * (MED / LOCO-I predictor, left neighbour on its first row) and the residuals are
+ * compressed with Oodle Mermaid, so strips encode and decode in parallel and a strip
+ * never depends on another one.
+ *
+ * File:    FFileHeader, then for each frame FFrameHeader + payload.
+ * Payload: uint32 NumBlocks, uint32 BlockSize[NumBlocks] (high bit = stored raw), blocks.
+ */
+class FAndroidCamera2LosslessCodec
+{
+public:
+	static constexpr int32 BlockRows = 64;
+	static constexpr uint32 StoredRawFlag = 0x80000000u;
+
+	struct FFileHeader
+	{
+		ANSICHAR Magic[4] = { 'A', 'C', '2', 'L' };
+		uint32 Version = 1;
+		uint32 Width = 0;
+		uint32 Height = 0;
+		uint32 FpsMilli = 30000;	// frames por segundo * 1000
+		uint32 BlockRows = FAndroidCamera2LosslessCodec::BlockRows;
+	};
+
+	struct FFrameHeader
+	{
+		ANSICHAR Magic[4] = { 'F', 'R', 'A', 'M' };
+		uint32 PayloadSize = 0;
+		uint64 Sequence = 0;
+		int64 TimestampUs = 0;
+	};
+
+	static int64 FrameBytes(int32 Width, int32 Height) { return static_cast<int64>(Width) * Height + 2 * static_cast<int64>(Width / 2) * (Height / 2); }
+
+	/** Compresses one tightly packed I420 frame into OutPayload (replaced). Not reentrant per instance. */
+	void Encode(const uint8* I420, int32 Width, int32 Height, TArray<uint8>& OutPayload);
+
+	/** Decodes a payload written by Encode into OutI420 (FrameBytes(Width, Height)). Not reentrant per instance. */
+	bool Decode(const uint8* Payload, int64 PayloadSize, int32 Width, int32 Height, uint8* OutI420);
+
+private:
+	struct FBlock
+	{
+		int64 Offset;	// en el frame I420
+		int32 Width;
+		int32 Rows;
+	};
+
+	static void BuildBlocks(int32 Width, int32 Height, TArray<FBlock>& OutBlocks);
+
+	TArray<FBlock> Blocks;
+	TArray<TArray<uint8>> Residuals;	// por bloque, reutilizados entre frames (también al decodificar)
+	TArray<TArray<uint8>> Compressed;
+	TArray<uint32> CompressedSizes;
+};
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+
+#include "AndroidCamera2PhotoDecoder.h"
+#include "AndroidCamera2Photo.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+
+#if PLATFORM_ANDROID
+THIRD_PARTY_INCLUDES_START
+#include "libyuv/convert_from_argb.h"
+THIRD_PARTY_INCLUDES_END
+#endif
+
+bool FAndroidCamera2PhotoDecoder::Decode(IImageWrapperModule& ImageWrapperModule, const uint8* Jpeg, int64 JpegSize, FAndroidCamera2Photo& OutPhoto, TArray64<uint8>* OutBGRA)
+{
+#if PLATFORM_ANDROID
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	TSharedPtr<IImageWrapper> Wrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::JPEG);
+	if (!Wrapper.IsValid() || !Wrapper->SetCompressed(Jpeg, JpegSize))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FAndroidCamera2PhotoDecoder::Decode::JPEG no válido (%lld bytes)"), JpegSize);
+		return false;
+	}
+
+	TArray64<uint8> BGRA;
+	if (!Wrapper->GetRaw(ERGBFormat::BGRA, 8, BGRA))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FAndroidCamera2PhotoDecoder::Decode::No se pudo decodificar el JPEG"));
+		return false;
+	}
+
+	// I420 con croma a mitad de resolución: tamaño par
+	const int32 SrcWidth = static_cast<int32>(Wrapper->GetWidth());
+	const int32 Width = SrcWidth & ~1;
+	const int32 Height = static_cast<int32>(Wrapper->GetHeight()) & ~1;
+	if (Width <= 0 || Height <= 0)
+	{
+		return false;
+	}
+
+	OutPhoto.Width = Width;
+	OutPhoto.Height = Height;
+	OutPhoto.Y.SetNumUninitialized(Width * Height);
+	OutPhoto.U.SetNumUninitialized((Width / 2) * (Height / 2));
+	OutPhoto.V.SetNumUninitialized((Width / 2) * (Height / 2));
+
+	// libyuv "ARGB" es BGRA en memoria
+	if (libyuv::ARGBToI420(BGRA.GetData(), SrcWidth * 4,
+		OutPhoto.Y.GetData(), Width,
+		OutPhoto.U.GetData(), Width / 2,
+		OutPhoto.V.GetData(), Width / 2,
+		Width, Height) != 0)
+	{
+		return false;
+	}
+
+	if (OutBGRA)
+	{
+		if (Width != SrcWidth)
+		{
+			for (int32 y = 1; y < Height; ++y)
+			{
+				FMemory::Memmove(BGRA.GetData() + static_cast<int64>(y) * Width * 4, BGRA.GetData() + static_cast<int64>(y) * SrcWidth * 4, Width * 4);
+			}
+		}
+		BGRA.SetNum(static_cast<int64>(Width) * Height * 4, EAllowShrinking::No);
+		*OutBGRA = MoveTemp(BGRA);
+	}
+
+	OutPhoto.DecodeMs = static_cast<float>((FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+	return true;
+#else
+	return false; // la captura de fotos solo existe en Android (libyuv)
+#endif
+}
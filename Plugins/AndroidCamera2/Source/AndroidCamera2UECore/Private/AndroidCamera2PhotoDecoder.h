@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IImageWrapperModule;
+struct FAndroidCamera2Photo;
+
+/**
+ * Decodes the still JPEG delivered by the camera into tightly packed I420 planes (and
+ * optionally keeps the BGRA image for a texture). Runs on a worker thread: the wrapper
+ * module must have been loaded on the game thread beforehand.
+ */
+class FAndroidCamera2PhotoDecoder
+{
+public:
+	/**
+	 * Fills Width, Height, Y, U, V and DecodeMs of OutPhoto. Odd sizes are cropped to even.
+	 * OutBGRA (optional) receives the decoded image, 4 bytes per pixel, at the cropped size.
+	 */
+	static bool Decode(IImageWrapperModule& ImageWrapperModule, const uint8* Jpeg, int64 JpegSize, FAndroidCamera2Photo& OutPhoto, TArray64<uint8>* OutBGRA);
+};
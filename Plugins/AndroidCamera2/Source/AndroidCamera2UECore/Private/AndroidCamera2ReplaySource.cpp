@@ -0,0 +1,298 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+
+#include "AndroidCamera2ReplaySource.h"
+#include "AndroidCamera2LosslessCodec.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+
+namespace AndroidCamera2Replay
+{
+	static constexpr ANSICHAR Y4MSignature[] = "YUV4MPEG2 ";
+	static constexpr ANSICHAR FrameSignature[] = "FRAME";
+
+	// Una línea de cabecera más larga que esto no es un Y4M razonable.
+	static constexpr int64 MaxHeaderLine = 4096;
+
+	// Solo 4:2:0 de 8 bits; C420p10/C420p12 usan 2 bytes por muestra.
+	static bool IsSupportedColorSpace(const FString& Value)
+	{
+		return Value == TEXT("420") || Value == TEXT("420jpeg") || Value == TEXT("420paldv") || Value == TEXT("420mpeg2");
+	}
+
+	static int64 FindNewLine(const uint8* Data, int64 From, int64 Size)
+	{
+		const int64 End = FMath::Min(Size, From + MaxHeaderLine);
+		for (int64 i = From; i < End; ++i)
+		{
+			if (Data[i] == '\n')
+			{
+				return i;
+			}
+		}
+		return INDEX_NONE;
+	}
+}
+
+FAndroidCamera2ReplaySource::~FAndroidCamera2ReplaySource()
+{
+	Close();
+}
+
+bool FAndroidCamera2ReplaySource::Open(const FString& FilePath, int32 RawWidth, int32 RawHeight, float RawFps)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	FOpenMappedResult Result = PlatformFile.OpenMappedEx(*FilePath);
+	if (Result.HasError())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FAndroidCamera2ReplaySource::Open::No se pudo abrir %s"), *FilePath);
+		return false;
+	}
+	MappedFile = Result.StealValue();
+
+	MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+	if (!MappedRegion)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FAndroidCamera2ReplaySource::Open::No se pudo mapear %s"), *FilePath);
+		Close();
+		return false;
+	}
+	Data = MappedRegion->GetMappedPtr();
+	DataSize = MappedRegion->GetMappedSize();
+
+	const int64 SignatureLen = UE_ARRAY_COUNT(AndroidCamera2Replay::Y4MSignature) - 1;
+	const bool bY4M = DataSize >= SignatureLen && FMemory::Memcmp(Data, AndroidCamera2Replay::Y4MSignature, SignatureLen) == 0;
+	bCompressed = DataSize >= static_cast<int64>(sizeof(FAndroidCamera2LosslessCodec::FFileHeader))
+		&& FMemory::Memcmp(Data, FAndroidCamera2LosslessCodec::FFileHeader().Magic, 4) == 0;
+	if (!bY4M && !bCompressed)
+	{
+		Width = RawWidth;
+		Height = RawHeight;
+		Fps = RawFps > 0.f ? RawFps : 30.0;
+	}
+
+	if (!(bY4M ? IndexY4M() : bCompressed ? IndexLossless() : IndexRaw()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FAndroidCamera2ReplaySource::Open::%s no contiene frames I420 válidos"), *FilePath);
+		Close();
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FAndroidCamera2ReplaySource::Open::%s: %d frames %dx%d @ %.2f fps"), *FilePath, FrameOffsets.Num(), Width, Height, Fps);
+	return true;
+}
+
+void FAndroidCamera2ReplaySource::Close()
+{
+	// El prefetch lee del fichero mapeado y escribe en DecodedFrames.
+	Prefetch.Wait();
+	Prefetch = UE::Tasks::FTask();
+	if (DecodedFrameCount > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("FAndroidCamera2ReplaySource::Close::%lld frames decodificados, %.2f ms/frame"), DecodedFrameCount.load(), GetDecodeMsPerFrame());
+	}
+	DecodedFrameCount = 0;
+	DecodeCycles = 0;
+
+	FrameOffsets.Empty();
+	bCompressed = false;
+	for (int32 Buffer = 0; Buffer < 2; ++Buffer)
+	{
+		DecodedFrames[Buffer].Empty();
+		DecodedIndex[Buffer] = INDEX_NONE;
+	}
+	CurrentBuffer = 0;
+	LastIndex = INDEX_NONE;
+	Data = nullptr;
+	DataSize = 0;
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+bool FAndroidCamera2ReplaySource::GetFrame(int32 Index, const uint8*& OutY, const uint8*& OutU, const uint8*& OutV)
+{
+	if (!FrameOffsets.IsValidIndex(Index))
+	{
+		return false;
+	}
+
+	if (bCompressed)
+	{
+		// Normalmente el prefetch ya terminó con este frame.
+		Prefetch.Wait();
+
+		int32 Buffer = (DecodedIndex[CurrentBuffer] == Index) ? CurrentBuffer : (DecodedIndex[CurrentBuffer ^ 1] == Index) ? (CurrentBuffer ^ 1) : INDEX_NONE;
+		if (Buffer == INDEX_NONE)
+		{
+			// Salto (seek, o el tick fue más lento que lo previsto): decodificar aquí.
+			Buffer = CurrentBuffer ^ 1;
+			if (!DecodeFrame(Buffer, Index))
+			{
+				return false;
+			}
+		}
+
+		// Siguiente frame según el paso del último GetFrame (RealTime puede saltar frames).
+		const int32 Step = (LastIndex != INDEX_NONE && Index > LastIndex) ? Index - LastIndex : 1;
+		const int32 Next = (Index + Step) % FrameOffsets.Num();
+		const int32 Other = Buffer ^ 1;
+		CurrentBuffer = Buffer;
+		LastIndex = Index;
+		if (Next != Index && DecodedIndex[Other] != Next)
+		{
+			Prefetch = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Other, Next]()
+			{
+				DecodeFrame(Other, Next);
+			});
+		}
+
+		OutY = DecodedFrames[Buffer].GetData();
+	}
+	else
+	{
+		OutY = Data + FrameOffsets[Index];
+	}
+	OutU = OutY + Width * Height;
+	OutV = OutU + (Width / 2) * (Height / 2);
+	return true;
+}
+
+bool FAndroidCamera2ReplaySource::DecodeFrame(int32 Buffer, int32 Index)
+{
+	FAndroidCamera2LosslessCodec::FFrameHeader Header;
+	FMemory::Memcpy(&Header, Data + FrameOffsets[Index], sizeof(Header));
+	DecodedFrames[Buffer].SetNumUninitialized(FAndroidCamera2LosslessCodec::FrameBytes(Width, Height), EAllowShrinking::No);
+	const uint64 DecodeStart = FPlatformTime::Cycles64();
+	const bool bOk = Codec->Decode(Data + FrameOffsets[Index] + sizeof(Header), Header.PayloadSize, Width, Height, DecodedFrames[Buffer].GetData());
+	DecodeCycles.fetch_add(FPlatformTime::Cycles64() - DecodeStart, std::memory_order_relaxed);
+	DecodedFrameCount.fetch_add(1, std::memory_order_relaxed);
+	DecodedIndex[Buffer] = bOk ? Index : INDEX_NONE;
+	return bOk;
+}
+
+double FAndroidCamera2ReplaySource::GetDecodeMsPerFrame() const
+{
+	const int64 Decoded = DecodedFrameCount.load(std::memory_order_relaxed);
+	return Decoded > 0 ? FPlatformTime::ToMilliseconds64(DecodeCycles.load(std::memory_order_relaxed)) / Decoded : 0.0;
+}
+
+bool FAndroidCamera2ReplaySource::IndexY4M()
+{
+	using namespace AndroidCamera2Replay;
+
+	const int64 HeaderEnd = FindNewLine(Data, 0, DataSize);
+	if (HeaderEnd == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Parámetros de la cabecera: W, H, F<num>:<den>, C<croma>; el resto se ignora.
+	const FString Header(static_cast<int32>(HeaderEnd), reinterpret_cast<const ANSICHAR*>(Data));
+	TArray<FString> Tokens;
+	Header.ParseIntoArray(Tokens, TEXT(" "));
+	Width = Height = 0;
+	Fps = 30.0;
+	for (const FString& Token : Tokens)
+	{
+		const TCHAR Tag = Token.Len() > 1 ? Token[0] : 0;
+		const FString Value = Token.Mid(1);
+		if (Tag == TEXT('W'))
+		{
+			Width = FCString::Atoi(*Value);
+		}
+		else if (Tag == TEXT('H'))
+		{
+			Height = FCString::Atoi(*Value);
+		}
+		else if (Tag == TEXT('F'))
+		{
+			FString Num, Den;
+			if (Value.Split(TEXT(":"), &Num, &Den) && FCString::Atoi(*Den) > 0 && FCString::Atoi(*Num) > 0)
+			{
+				Fps = static_cast<double>(FCString::Atoi(*Num)) / FCString::Atoi(*Den);
+			}
+		}
+		else if (Tag == TEXT('C') && !IsSupportedColorSpace(Value))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FAndroidCamera2ReplaySource::IndexY4M::Croma %s no soportado, solo 4:2:0 de 8 bits"), *Value);
+			return false;
+		}
+	}
+
+	if (Width <= 0 || Height <= 0)
+	{
+		return false;
+	}
+
+	const int64 FrameBytes = static_cast<int64>(Width) * Height + 2 * static_cast<int64>(Width / 2) * (Height / 2);
+	const int64 FrameSignatureLen = UE_ARRAY_COUNT(FrameSignature) - 1;
+	int64 Offset = HeaderEnd + 1;
+	while (Offset + FrameSignatureLen <= DataSize && FMemory::Memcmp(Data + Offset, FrameSignature, FrameSignatureLen) == 0)
+	{
+		const int64 LineEnd = FindNewLine(Data, Offset, DataSize);
+		if (LineEnd == INDEX_NONE || LineEnd + 1 + FrameBytes > DataSize)
+		{
+			break; // último frame incompleto (grabación cortada)
+		}
+		FrameOffsets.Add(LineEnd + 1);
+		Offset = LineEnd + 1 + FrameBytes;
+	}
+
+	return FrameOffsets.Num() > 0;
+}
+
+bool FAndroidCamera2ReplaySource::IndexRaw()
+{
+	if (Width <= 0 || Height <= 0)
+	{
+		return false;
+	}
+
+	const int64 FrameBytes = static_cast<int64>(Width) * Height + 2 * static_cast<int64>(Width / 2) * (Height / 2);
+	const int64 NumFrames = DataSize / FrameBytes;
+	FrameOffsets.Reserve(static_cast<int32>(NumFrames));
+	for (int64 i = 0; i < NumFrames; ++i)
+	{
+		FrameOffsets.Add(i * FrameBytes);
+	}
+
+	return FrameOffsets.Num() > 0;
+}
+
+bool FAndroidCamera2ReplaySource::IndexLossless()
+{
+	using FCodec = FAndroidCamera2LosslessCodec;
+
+	FCodec::FFileHeader Header;
+	FMemory::Memcpy(&Header, Data, sizeof(Header));
+	if (Header.Version != 1 || Header.BlockRows != FCodec::BlockRows || Header.Width == 0 || Header.Height == 0)
+	{
+		return false;
+	}
+	Width = static_cast<int32>(Header.Width);
+	Height = static_cast<int32>(Header.Height);
+	Fps = Header.FpsMilli > 0 ? Header.FpsMilli / 1000.0 : 30.0;
+	if (!Codec)
+	{
+		Codec = MakeUnique<FCodec>();
+	}
+
+	int64 Offset = sizeof(Header);
+	while (Offset + static_cast<int64>(sizeof(FCodec::FFrameHeader)) <= DataSize)
+	{
+		FCodec::FFrameHeader FrameHeader;
+		FMemory::Memcpy(&FrameHeader, Data + Offset, sizeof(FrameHeader));
+		const int64 End = Offset + sizeof(FrameHeader) + FrameHeader.PayloadSize;
+		if (FMemory::Memcmp(FrameHeader.Magic, FCodec::FFrameHeader().Magic, 4) != 0 || End > DataSize)
+		{
+			break; // último frame incompleto (grabación cortada)
+		}
+		FrameOffsets.Add(Offset);
+		Offset = End;
+	}
+
+	return FrameOffsets.Num() > 0;
+}
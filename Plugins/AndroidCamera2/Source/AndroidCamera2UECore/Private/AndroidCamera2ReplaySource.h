@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include <atomic>
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+class FAndroidCamera2LosslessCodec;
+
+/**
+ * Read-only, memory-mapped I420 recording: Y4M (420 chroma) or lossless .ac2l, as
+ * written by FAndroidCamera2FrameRecorder, or raw back-to-back I420 frames of a
+ * known size.
+ *
+ * Open indexes the frame offsets once. For Y4M/raw GetFrame returns pointers straight
+ * into the mapping, so playing a frame back copies nothing. .ac2l frames are decoded
+ * into two internal buffers, valid until the next GetFrame: while the caller uses one,
+ * a worker task decodes the frame expected next into the other, so GetFrame only
+ * decodes on the calling thread after a seek. Pointers never outlive Close.
+ */
+class FAndroidCamera2ReplaySource
+{
+public:
+	~FAndroidCamera2ReplaySource();
+
+	/**
+	 * Maps the file. Y4M and .ac2l are detected by their signature; anything else is
+	 * read as raw I420 of RawWidth x RawHeight at RawFps.
+	 */
+	bool Open(const FString& FilePath, int32 RawWidth, int32 RawHeight, float RawFps);
+	void Close();
+
+	bool IsOpen() const { return FrameOffsets.Num() > 0; }
+	bool IsCompressed() const { return bCompressed; }
+	int32 GetNumFrames() const { return FrameOffsets.Num(); }
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+	double GetFps() const { return Fps; }
+
+	/** Average .ac2l decode time per frame, wherever it ran (0 for Y4M/raw). */
+	double GetDecodeMsPerFrame() const;
+
+	/** Planes of frame Index (tightly packed: Y is Width x Height, U and V Width/2 x Height/2). */
+	bool GetFrame(int32 Index, const uint8*& OutY, const uint8*& OutU, const uint8*& OutV);
+
+private:
+	bool IndexY4M();
+	bool IndexRaw();
+	bool IndexLossless();
+
+	/** Decodes frame Index into DecodedFrames[Buffer]. Game thread or the prefetch task, never both. */
+	bool DecodeFrame(int32 Buffer, int32 Index);
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+
+	TArray<int64> FrameOffsets;		// datos del frame (en .ac2l, su FFrameHeader)
+	bool bCompressed = false;
+	TUniquePtr<FAndroidCamera2LosslessCodec> Codec;	// solo .ac2l
+	TArray<uint8> DecodedFrames[2];
+	int32 DecodedIndex[2] = { INDEX_NONE, INDEX_NONE };
+	int32 CurrentBuffer = 0;			// devuelto por el último GetFrame
+	int32 LastIndex = INDEX_NONE;
+	UE::Tasks::FTask Prefetch;			// decodifica en el otro buffer
+	std::atomic<int64> DecodedFrameCount{ 0 };
+	std::atomic<uint64> DecodeCycles{ 0 };
+	int32 Width = 0, Height = 0;
+	double Fps = 30.0;
+};
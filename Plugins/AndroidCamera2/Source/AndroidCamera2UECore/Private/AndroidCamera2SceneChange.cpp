@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+
+#include "AndroidCamera2SceneChange.h"
+
+#if PLATFORM_ANDROID
+THIRD_PARTY_INCLUDES_START
+#include "libyuv/compare.h"
+#include "libyuv/scale.h"
+THIRD_PARTY_INCLUDES_END
+#endif
+
+void FAndroidCamera2SceneChange::Reset()
+{
+	StaticFrames = 0;
+	Score = 0.f;
+	bStatic = false;
+	bHasReference = false;
+}
+
+void FAndroidCamera2SceneChange::Downscale(const uint8* Luma, int32 Width, int32 Height, int32 Stride)
+{
+#if PLATFORM_ANDROID
+	libyuv::ScalePlane(Luma, Stride, Width, Height, Current.GetData(), SmallW, SmallW, SmallH, libyuv::kFilterBox);
+#else
+	const int32 FX = Width / SmallW;
+	const int32 FY = Height / SmallH;
+	const int32 Area = FX * FY;
+
+	for (int32 Y = 0; Y < SmallH; ++Y)
+	{
+		uint8* Dst = Current.GetData() + Y * SmallW;
+		for (int32 X = 0; X < SmallW; ++X)
+		{
+			uint32 Sum = 0;
+			const uint8* Src = Luma + (Y * FY) * Stride + X * FX;
+			for (int32 j = 0; j < FY; ++j, Src += Stride)
+			{
+				for (int32 i = 0; i < FX; ++i)
+				{
+					Sum += Src[i];
+				}
+			}
+			Dst[X] = static_cast<uint8>((Sum + Area / 2) / Area);
+		}
+	}
+#endif
+}
+
+uint64 FAndroidCamera2SceneChange::SumSquareError() const
+{
+#if PLATFORM_ANDROID
+	return libyuv::ComputeSumSquareErrorPlane(Current.GetData(), SmallW, Reference.GetData(), SmallW, SmallW, SmallH);
+#else
+	uint64 Sum = 0;
+	for (int32 i = 0; i < Current.Num(); ++i)
+	{
+		const int32 D = static_cast<int32>(Current[i]) - static_cast<int32>(Reference[i]);
+		Sum += static_cast<uint64>(D * D);
+	}
+	return Sum;
+#endif
+}
+
+bool FAndroidCamera2SceneChange::Update(const uint8* Luma, int32 Width, int32 Height, int32 Stride,
+                                        int32 Downsample, float Threshold, int32 MaxStaticFrames)
+{
+	if (!Luma || Width <= 0 || Height <= 0 || Stride < Width)
+	{
+		return true;
+	}
+
+	Downsample = FMath::Max(1, Downsample);
+	const int32 W = FMath::Max(1, Width / Downsample);
+	const int32 H = FMath::Max(1, Height / Downsample);
+
+	if (W != SmallW || H != SmallH)
+	{
+		SmallW = W;
+		SmallH = H;
+		Current.SetNumUninitialized(W * H);
+		Reference.SetNumUninitialized(W * H);
+		bHasReference = false;
+	}
+
+	Downscale(Luma, Width, Height, Stride);
+
+	bool bChanged = true;
+	if (bHasReference)
+	{
+		Score = static_cast<float>(static_cast<double>(SumSquareError()) / (SmallW * SmallH));
+		bChanged = Score >= Threshold || (MaxStaticFrames > 0 && StaticFrames >= MaxStaticFrames);
+	}
+	else
+	{
+		// Sin referencia: cambio máximo posible.
+		Score = 255.f * 255.f;
+	}
+
+	if (bChanged)
+	{
+		Swap(Current, Reference);
+		bHasReference = true;
+		StaticFrames = 0;
+	}
+	else
+	{
+		++StaticFrames;
+	}
+
+	bStatic = !bChanged;
+	return bChanged;
+}
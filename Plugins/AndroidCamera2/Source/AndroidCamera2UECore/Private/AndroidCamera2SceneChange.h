@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Puntuación de cambio de escena por frame: MSE entre una copia reducida de la
+ * luminancia y la del último frame que contó como cambio. Al comparar contra ese
+ * frame (y no contra el anterior) una deriva lenta acaba superando el umbral.
+ * En Android usa libyuv (ScalePlane box + ComputeSumSquareErrorPlane, NEON).
+ */
+class FAndroidCamera2SceneChange
+{
+public:
+	/**
+	 * @param Downsample      Factor de reducción por eje (>= 1)
+	 * @param Threshold       MSE a partir del cual el frame cuenta como cambio
+	 * @param MaxStaticFrames Frames estáticos seguidos antes de forzar un cambio (0 = nunca)
+	 * @return true si el frame cuenta como cambio.
+	 */
+	bool Update(const uint8* Luma, int32 Width, int32 Height, int32 Stride,
+	            int32 Downsample, float Threshold, int32 MaxStaticFrames);
+
+	float GetScore() const { return Score; }
+	bool IsStatic() const { return bStatic; }
+	void Reset();
+
+private:
+	void Downscale(const uint8* Luma, int32 Width, int32 Height, int32 Stride);
+	uint64 SumSquareError() const;
+
+	TArray<uint8> Current;
+	TArray<uint8> Reference;
+	int32 SmallW = 0;
+	int32 SmallH = 0;
+	int32 StaticFrames = 0;
+	float Score = 0.f;
+	bool bStatic = false;
+	bool bHasReference = false;
+};
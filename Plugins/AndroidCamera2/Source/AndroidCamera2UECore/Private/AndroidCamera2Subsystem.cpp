@@ -4,11 +4,27 @@
 
 #include "AndroidCamera2Subsystem.h"
 #include "AndroidCamera2Settings.h"
+#include "AndroidCamera2SceneChange.h"
+#include "AndroidCamera2LatencyHistogram.h"
+#include "AndroidCamera2FrameTrace.h"
+#include "AndroidCamera2Telemetry.h"
+#include "AndroidCamera2FrameRecorder.h"
+#include "AndroidCamera2ReplaySource.h"
+#include "AndroidCamera2PhotoDecoder.h"
+#include "AndroidCamera2FrameRing.h"
+#include "AndroidCamera2ImageSaver.h"
+#include "RenderingThread.h"
+#include "Misc/Paths.h"
 #include "Stats/Stats.h"
 #include "Engine/TextureRenderTarget2D.h"
+#include "Engine/Texture2D.h"
+#include "IImageWrapperModule.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
 #include "IMediaClockSink.h"
 #include "IMediaModule.h"
 #include "IMediaClock.h"
+#include <atomic>
 
 #if PLATFORM_ANDROID
 #include "AndroidCamera2Java.h"
@@ -21,6 +37,63 @@ DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("1. Upload Media TickFetch - RenderThread
 DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("1. Upload Media TickFetch - GameThread spikes >2ms in 1 sec [%]"), STAT_MediaTickFetchCPUSpikesPct_1s, STATGROUP_AndroidCamera2, );
 DEFINE_STAT(STAT_MediaTickFetchGPUSpikesPct_1s);
 DEFINE_STAT(STAT_MediaTickFetchCPUSpikesPct_1s);
+DECLARE_CYCLE_STAT(TEXT("Scene Change Score - GameThread (CPU)"), STAT_SceneChange_GT, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("2. Scene change score [MSE]"), STAT_SceneChangeScore, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("2. Upload Media skipped (static scene) in 1 sec [%]"), STAT_UploadSkippedPct_1s, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("3. TickFetch GameThread p50 [ms]"), STAT_LatencyGT_P50, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("3. TickFetch GameThread p95 [ms]"), STAT_LatencyGT_P95, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("3. TickFetch GameThread p99 [ms]"), STAT_LatencyGT_P99, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("3. TickFetch GameThread max [ms]"), STAT_LatencyGT_Max, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("4. Upload RenderThread p50 [ms]"), STAT_LatencyRT_P50, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("4. Upload RenderThread p95 [ms]"), STAT_LatencyRT_P95, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("4. Upload RenderThread p99 [ms]"), STAT_LatencyRT_P99, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("4. Upload RenderThread max [ms]"), STAT_LatencyRT_Max, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("5. Java I420 conversion p50 [ms]"), STAT_LatencyJava_P50, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("5. Java I420 conversion p95 [ms]"), STAT_LatencyJava_P95, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("5. Java I420 conversion p99 [ms]"), STAT_LatencyJava_P99, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("5. Java I420 conversion max [ms]"), STAT_LatencyJava_Max, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("7. Sensor -> TickFetch p50 [ms]"), STAT_LatencyS2F_P50, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("7. Sensor -> TickFetch p95 [ms]"), STAT_LatencyS2F_P95, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("7. Sensor -> TickFetch p99 [ms]"), STAT_LatencyS2F_P99, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("7. Sensor -> TickFetch max [ms]"), STAT_LatencyS2F_Max, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("8. TickFetch -> Uploaded p50 [ms]"), STAT_LatencyF2U_P50, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("8. TickFetch -> Uploaded p95 [ms]"), STAT_LatencyF2U_P95, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("8. TickFetch -> Uploaded p99 [ms]"), STAT_LatencyF2U_P99, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("8. TickFetch -> Uploaded max [ms]"), STAT_LatencyF2U_Max, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("9. Sensor -> Uploaded p50 [ms]"), STAT_LatencyS2U_P50, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("9. Sensor -> Uploaded p95 [ms]"), STAT_LatencyS2U_P95, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("9. Sensor -> Uploaded p99 [ms]"), STAT_LatencyS2U_P99, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("9. Sensor -> Uploaded max [ms]"), STAT_LatencyS2U_Max, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("10. Sensor -> QR decoded p50 [ms]"), STAT_LatencyS2QR_P50, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("10. Sensor -> QR decoded p95 [ms]"), STAT_LatencyS2QR_P95, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("10. Sensor -> QR decoded p99 [ms]"), STAT_LatencyS2QR_P99, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("10. Sensor -> QR decoded max [ms]"), STAT_LatencyS2QR_Max, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("11. Sensor frames/s"), STAT_SensorFps, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("11. Delivered frames/s"), STAT_DeliveredFps, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("11. Uploaded frames/s"), STAT_UploadedFps, STATGROUP_AndroidCamera2);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("12. Frames dropped in ImageReader"), STAT_DroppedInReader, STATGROUP_AndroidCamera2);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("12. Frames dropped by listener drain"), STAT_DroppedDrain, STATGROUP_AndroidCamera2);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("12. Frames dropped (C++ reading)"), STAT_DroppedBusy, STATGROUP_AndroidCamera2);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("12. Frames dropped before TickFetch"), STAT_DroppedBeforeFetch, STATGROUP_AndroidCamera2);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("12. Frames re-used by TickFetch"), STAT_ReusedFrames, STATGROUP_AndroidCamera2);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("13. Frames recorded to Y4M"), STAT_RecordedFrames, STATGROUP_AndroidCamera2);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("13. Frames dropped by the recorder"), STAT_RecorderDroppedFrames, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("13. Recorder lossless encode (writer) [ms/frame]"), STAT_RecorderEncodeMs, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("13. Replay lossless decode (worker) [ms/frame]"), STAT_ReplayDecodeMs, STATGROUP_AndroidCamera2);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("14. Last photo decode (worker) [ms]"), STAT_PhotoDecodeMs, STATGROUP_AndroidCamera2);
+
+#if STATS
+#define SET_LATENCY_STATS(Histogram, StatPrefix) \
+    { \
+        const FAndroidCamera2LatencyStats LatencyStats = (Histogram).GetStats(); \
+        SET_FLOAT_STAT(StatPrefix##_P50, LatencyStats.P50Ms); \
+        SET_FLOAT_STAT(StatPrefix##_P95, LatencyStats.P95Ms); \
+        SET_FLOAT_STAT(StatPrefix##_P99, LatencyStats.P99Ms); \
+        SET_FLOAT_STAT(StatPrefix##_Max, LatencyStats.MaxMs); \
+    }
+#else
+#define SET_LATENCY_STATS(Histogram, StatPrefix)
+#endif
 
 struct FRollingSpikeCounter
 {
@@ -69,6 +142,35 @@ class FAndroidCamera2ThreadSafe
 public:
 
     TArray<uint8> YBuffer, UBuffer, VBuffer;
+    FAndroidCamera2SceneChange SceneChange; // solo GameThread
+    FAndroidCamera2LatencyHistogram Latency[static_cast<int32>(EAndroidCamera2LatencyStage::Count)];
+    FAndroidCamera2FrameTimes FrameTimes; // último frame recogido, solo GameThread
+    FAndroidCamera2FrameCounters Counters; // solo GameThread, salvo UploadedFrames
+    std::atomic<int64> UploadedFrames{ 0 };
+    uint64 LastSkippedSequence = 0;
+    double RateStartSeconds = 0.0;
+    int64 RateSensorFrames = 0, RateDeliveredFrames = 0, RateUploadedFrames = 0;
+    FRollingSpikeCounter UploadSkipped{ 1.0, 10 };   // 10 buckets de 100 ms
+    FAndroidCamera2TelemetryRecorder Telemetry;
+    FAndroidCamera2FrameRecorder FrameRecorder;
+    FAndroidCamera2FrameRing ZeroShutterLag; // solo GameThread
+    TSharedRef<FAndroidCamera2ImageSaver, ESPMode::ThreadSafe> ImageSaver = MakeShared<FAndroidCamera2ImageSaver, ESPMode::ThreadSafe>();
+    struct FPendingFrameSave
+    {
+        FString FilePath;
+        EAndroidCamera2ImageFormat Format;
+        int32 Quality;
+        FAndroidCamera2ImageSaver::FOnSaved OnSaved;
+    };
+    TArray<FPendingFrameSave> PendingFrameSaves; // se guardan con el siguiente frame nuevo
+    int32 TargetFps = 30;
+    TUniquePtr<FAndroidCamera2ReplaySource> Replay; // fuente de frames desde fichero en lugar de la cámara
+    EAndroidCamera2ReplayPacing ReplayPacing = EAndroidCamera2ReplayPacing::RealTime;
+    bool bReplayLoop = false;
+    bool bReplayFinished = false;
+    int64 ReplayFrame = INDEX_NONE; // frames reproducidos - 1, sin volver a 0 al repetir
+    double ReplayStartSeconds = 0.0;
+    uint64 ReplayStartCycles = 0;
     void* yJavaBuffer = nullptr;
     void* uJavaBuffer = nullptr;
     void* vJavaBuffer = nullptr;
@@ -110,49 +212,321 @@ public:
 #endif
     }
 
+    void CopyPlanes()
+    {
+        if (bUpdateYBuffer && yJavaBuffer)
+        {
+            const int32 BytesY = Width * Height;
+            FMemory::Memcpy(YBuffer.GetData(), yJavaBuffer, BytesY);
+        }
+
+        const int32 BytesUV = (Width * Height) / 4;
+        if (bUpdateUBuffer && uJavaBuffer)
+        {
+            FMemory::Memcpy(UBuffer.GetData(), uJavaBuffer, BytesUV);
+        }
+
+        if (bUpdateVBuffer && vJavaBuffer)
+        {
+            FMemory::Memcpy(VBuffer.GetData(), vJavaBuffer, BytesUV);
+        }
+    }
+
     void GetLastFrameInfo()
     {
+        if (Replay)
+        {
+            GetReplayFrame();
+            return;
+        }
+
         if (bOnRenderQueued && GetJavaLastFrameTimeStamp() == TimeStampCycles64)
+        {
+            ++Counters.ReusedFrames;
             return;
+        }
 
 #if PLATFORM_ANDROID
         
         int32 imgWidth = 0;
         int32 imgHeight = 0;
         int64 TimeStampNanos = 0;
-        AndroidCamera2Java->GetLastPreviewFrameInfo(yJavaBuffer, uJavaBuffer, vJavaBuffer, imgWidth, imgHeight, TimeStampNanos); //This call block java side updates on JavaBuffers
+        FAndroidCamera2JavaFrameTimes JavaTimes;
+        FAndroidCamera2JavaFrameCounters JavaCounters;
+        const bool bFrameInfo = AndroidCamera2Java->GetLastPreviewFrameInfo(yJavaBuffer, uJavaBuffer, vJavaBuffer, imgWidth, imgHeight, TimeStampNanos, JavaTimes, JavaCounters); //This call block java side updates on JavaBuffers
 		TimeStampCycles64 = ConvertTimeStampMicrosToCycles64(TimeStampNanos/1000);
 
-        CheckBuffersSize(imgWidth, imgHeight);
+        // Una muestra por frame nuevo de Java
+        const bool bNewFrame = JavaTimes.FrameNumber > 0 && static_cast<uint64>(JavaTimes.FrameNumber) != FrameTimes.Sequence;
+        if (bNewFrame)
+        {
+            OnNewJavaFrame(JavaTimes);
+        }
+        else
+        {
+            ++Counters.ReusedFrames;
+        }
 
-        if (bUpdateYBuffer && yJavaBuffer)
+        if (bFrameInfo)
         {
-            const int32 BytesY = Width * Height;
-            FMemory::Memcpy(YBuffer.GetData(), yJavaBuffer, BytesY);
+            Counters.SensorFrames = JavaCounters.SensorFrames;
+            Counters.DroppedInReader = FMath::Max<int64>(0, JavaCounters.SensorFrames - JavaCounters.ImagesAcquired);
+            Counters.DroppedDrain = JavaCounters.DroppedDrain;
+            Counters.DroppedBusy = JavaCounters.DroppedBusy;
         }
 
-        const int32 BytesUV = (Width * Height) / 4;
-        if (bUpdateUBuffer && uJavaBuffer)
+        CheckBuffersSize(imgWidth, imgHeight);
+        CopyPlanes();
+
+        // Copia a un buffer del pool mientras Java no puede tocar los buffers
+        if (bNewFrame && FrameRecorder.IsRecording())
         {
-            FMemory::Memcpy(UBuffer.GetData(), uJavaBuffer, BytesUV);
+            FrameRecorder.PushFrame(static_cast<const uint8*>(yJavaBuffer), static_cast<const uint8*>(uJavaBuffer), static_cast<const uint8*>(vJavaBuffer),
+                Width, Height, FrameTimes.Sequence, TimeStampNanos / 1000);
+        }
+        if (bNewFrame && PendingFrameSaves.Num() > 0)
+        {
+            SavePendingFrames(static_cast<const uint8*>(yJavaBuffer), static_cast<const uint8*>(uJavaBuffer), static_cast<const uint8*>(vJavaBuffer), Width, Height);
+        }
+        if (bNewFrame && ZeroShutterLag.IsEnabled())
+        {
+            ZeroShutterLag.Push(static_cast<const uint8*>(yJavaBuffer), static_cast<const uint8*>(uJavaBuffer), static_cast<const uint8*>(vJavaBuffer),
+                Width, Height, FrameTimes.Sequence, TimeStampCycles64);
         }
 
-        if (bUpdateVBuffer && vJavaBuffer)
+        // Sin RTs los buffers se liberan en UpdateRenderTextures, después de que UpdateSceneChange los haya muestreado.
+#endif
+    }
+
+#if PLATFORM_ANDROID
+    void OnNewJavaFrame(const FAndroidCamera2JavaFrameTimes& JavaTimes)
+    {
+        const uint64 FetchCycles = FPlatformTime::Cycles64();
+
+        // Huecos en la secuencia: frames convertidos que Java sobrescribió antes de recogerlos.
+        const uint64 Sequence = static_cast<uint64>(JavaTimes.FrameNumber);
+        Counters.DroppedBeforeFetch += (Sequence > FrameTimes.Sequence) ? Sequence - FrameTimes.Sequence - 1 : Sequence - 1;
+        Counters.ConvertedFrames = JavaTimes.FrameNumber;
+        ++Counters.DeliveredFrames;
+
+        FrameTimes = FAndroidCamera2FrameTimes();
+        FrameTimes.Sequence = Sequence;
+        FrameTimes.Mark(EAndroidCamera2FrameStage::SensorExposure, ConvertTimeStampMicrosToCycles64(JavaTimes.ExposureNanos / 1000));
+        FrameTimes.Mark(EAndroidCamera2FrameStage::JavaArrival, ConvertTimeStampMicrosToCycles64(JavaTimes.ArrivalNanos / 1000));
+        FrameTimes.Mark(EAndroidCamera2FrameStage::JavaConverted, ConvertTimeStampMicrosToCycles64(JavaTimes.ConvertedNanos / 1000));
+        FrameTimes.Mark(EAndroidCamera2FrameStage::NativeFetch, FetchCycles);
+
+        if (JavaTimes.ConversionNanos > 0)
         {
-            FMemory::Memcpy(VBuffer.GetData(), vJavaBuffer, BytesUV);
+            GetLatency(EAndroidCamera2LatencyStage::JavaConversion).AddSample(JavaTimes.ConversionNanos * 1e-6);
         }
+        AddSpan(EAndroidCamera2LatencyStage::SensorToFetch, FrameTimes, EAndroidCamera2FrameStage::SensorExposure, EAndroidCamera2FrameStage::NativeFetch);
 
-        if (!bRenderYRT && !bRenderURT && !bRenderVRT)
+        if (FAndroidCamera2TelemetryRecord* Record = Telemetry.Begin(FrameTimes))
         {
-            AndroidCamera2Java->ReleaseLastPreviewFrameInfo();
+            Record->JavaConversionUs = static_cast<uint32>(JavaTimes.ConversionNanos / 1000);
+            Telemetry.Commit(Record);
         }
+    }
 #endif
+
+    /** Completa el registro de telemetría del frame recogido en este TickFetch. */
+    void RecordTelemetry(uint64 GameThreadCycles)
+    {
+        FAndroidCamera2TelemetryRecord* Record = Telemetry.Find(FrameTimes.Sequence);
+        if (!Record)
+            return;
+        if (Record->GameThreadUs != 0)
+        {
+            Telemetry.Commit(Record); // frame re-usado
+            return;
+        }
+
+        auto Clamp32 = [](int64 Value) { return static_cast<uint32>(FMath::Clamp<int64>(Value, 0, MAX_uint32)); };
+        Record->GameThreadUs = FMath::Max(1u, FAndroidCamera2TelemetryRecorder::CyclesToUs(GameThreadCycles));
+        Record->Width = static_cast<uint16>(FMath::Clamp(Width, 0, 65535));
+        Record->Height = static_cast<uint16>(FMath::Clamp(Height, 0, 65535));
+        Record->DroppedInReader = Clamp32(Counters.DroppedInReader);
+        Record->DroppedDrain = Clamp32(Counters.DroppedDrain);
+        Record->DroppedBusy = Clamp32(Counters.DroppedBusy);
+        Record->DroppedBeforeFetch = Clamp32(Counters.DroppedBeforeFetch);
+        Record->bSkippedStatic = (LastSkippedSequence == FrameTimes.Sequence) ? 1 : 0;
+        Telemetry.Commit(Record);
+    }
+
+    bool StartReplay(const FString& FilePath, EAndroidCamera2ReplayPacing Pacing, bool bLoop, int32 RawWidth, int32 RawHeight, float RawFps)
+    {
+        StopReplay();
+        ResetFrameCounters();
+
+        TUniquePtr<FAndroidCamera2ReplaySource> Source = MakeUnique<FAndroidCamera2ReplaySource>();
+        if (!Source->Open(FilePath, RawWidth, RawHeight, RawFps))
+            return false;
+
+        Replay = MoveTemp(Source);
+        ReplayPacing = Pacing;
+        bReplayLoop = bLoop;
+        bReplayFinished = false;
+        ReplayFrame = INDEX_NONE;
+        TargetFps = FMath::RoundToInt(Replay->GetFps());
+        ReplayStartSeconds = FPlatformTime::Seconds();
+        ReplayStartCycles = FPlatformTime::Cycles64();
+        return true;
+    }
+
+    void StopReplay()
+    {
+        if (!Replay)
+            return;
+
+        // El render thread puede estar subiendo directamente desde el fichero mapeado.
+        FlushRenderingCommands();
+        bOnRenderQueued = false;
+        yJavaBuffer = uJavaBuffer = vJavaBuffer = nullptr;
+        Replay.Reset();
+    }
+
+    /** Equivalente a GetLastFrameInfo para la reproducción: sin copias salvo los buffers pedidos en Settings. */
+    void GetReplayFrame()
+    {
+        // Los frames comprimidos se decodifican en dos buffers y el prefetch reescribe el del frame
+        // anterior: esperar a que el render thread lo suelte.
+        if (bOnRenderQueued && Replay->IsCompressed())
+        {
+            ++Counters.ReusedFrames;
+            return;
+        }
+
+        const int32 NumFrames = Replay->GetNumFrames();
+        int64 Frame = (ReplayPacing == EAndroidCamera2ReplayPacing::AsFastAsPossible)
+            ? ReplayFrame + 1
+            : static_cast<int64>((FPlatformTime::Seconds() - ReplayStartSeconds) * Replay->GetFps());
+        if (!bReplayLoop && Frame >= NumFrames)
+        {
+            Frame = NumFrames - 1;
+            bReplayFinished = true;
+        }
+
+        if (Frame == ReplayFrame)
+        {
+            ++Counters.ReusedFrames;
+            return;
+        }
+
+        const uint8 *Y = nullptr, *U = nullptr, *V = nullptr;
+        if (!Replay->GetFrame(static_cast<int32>(Frame % NumFrames), Y, U, V))
+            return;
+
+        const uint64 FetchCycles = FPlatformTime::Cycles64();
+        const uint64 Sequence = static_cast<uint64>(Frame + 1);
+        Counters.DroppedBeforeFetch += Frame - ReplayFrame - 1; // RealTime: ticks más lentos que el fichero
+        Counters.SensorFrames = Counters.ConvertedFrames = Sequence;
+        ++Counters.DeliveredFrames;
+        ReplayFrame = Frame;
+
+        // Marca de tiempo sintética: cuándo le tocaba al frame según el framerate del fichero.
+        TimeStampCycles64 = ReplayStartCycles + static_cast<uint64>(Frame / Replay->GetFps() / FPlatformTime::GetSecondsPerCycle64());
+
+        FrameTimes = FAndroidCamera2FrameTimes();
+        FrameTimes.Sequence = Sequence;
+        if (ReplayPacing == EAndroidCamera2ReplayPacing::RealTime)
+        {
+            FrameTimes.Mark(EAndroidCamera2FrameStage::SensorExposure, TimeStampCycles64);
+        }
+        FrameTimes.Mark(EAndroidCamera2FrameStage::NativeFetch, FetchCycles);
+        AddSpan(EAndroidCamera2LatencyStage::SensorToFetch, FrameTimes, EAndroidCamera2FrameStage::SensorExposure, EAndroidCamera2FrameStage::NativeFetch);
+        Telemetry.Commit(Telemetry.Begin(FrameTimes));
+
+        yJavaBuffer = const_cast<uint8*>(Y);
+        uJavaBuffer = const_cast<uint8*>(U);
+        vJavaBuffer = const_cast<uint8*>(V);
+        CheckBuffersSize(Replay->GetWidth(), Replay->GetHeight());
+        CopyPlanes();
+
+        if (ZeroShutterLag.IsEnabled())
+        {
+            ZeroShutterLag.Push(Y, U, V, Replay->GetWidth(), Replay->GetHeight(), Sequence, TimeStampCycles64);
+        }
+        if (PendingFrameSaves.Num() > 0)
+        {
+            SavePendingFrames(Y, U, V, Replay->GetWidth(), Replay->GetHeight());
+        }
+    }
+
+    /** Lanza los guardados pedidos con SaveNextFrame sobre este frame (la copia se hace aquí, con Java bloqueado). */
+    void SavePendingFrames(const uint8* Y, const uint8* U, const uint8* V, int32 InWidth, int32 InHeight)
+    {
+        for (FPendingFrameSave& Pending : PendingFrameSaves)
+        {
+            if (!ImageSaver->Save(Y, U, V, InWidth, InHeight, Pending.FilePath, Pending.Format, Pending.Quality, Pending.OnSaved) && Pending.OnSaved)
+            {
+                Pending.OnSaved(false, Pending.FilePath);
+            }
+        }
+        PendingFrameSaves.Reset();
+    }
+
+    void CancelPendingFrameSaves()
+    {
+        for (FPendingFrameSave& Pending : PendingFrameSaves)
+        {
+            if (Pending.OnSaved)
+            {
+                Pending.OnSaved(false, Pending.FilePath);
+            }
+        }
+        PendingFrameSaves.Reset();
+    }
+
+    void ResetFrameCounters()
+    {
+        Counters = FAndroidCamera2FrameCounters();
+        UploadedFrames = 0;
+        FrameTimes = FAndroidCamera2FrameTimes();
+        LastSkippedSequence = 0;
+        ZeroShutterLag.Reset();
+        RateStartSeconds = FPlatformTime::Seconds();
+        RateSensorFrames = RateDeliveredFrames = RateUploadedFrames = 0;
+    }
+
+    /** Frames por segundo, recalculados una vez por segundo. */
+    void UpdateFrameRates()
+    {
+        const double Now = FPlatformTime::Seconds();
+        const double Elapsed = Now - RateStartSeconds;
+        if (Elapsed < 1.0)
+            return;
+
+        const int64 Uploaded = UploadedFrames.load(std::memory_order_relaxed);
+        Counters.SensorFps = static_cast<float>((Counters.SensorFrames - RateSensorFrames) / Elapsed);
+        Counters.DeliveredFps = static_cast<float>((Counters.DeliveredFrames - RateDeliveredFrames) / Elapsed);
+        Counters.UploadedFps = static_cast<float>((Uploaded - RateUploadedFrames) / Elapsed);
+
+        RateStartSeconds = Now;
+        RateSensorFrames = Counters.SensorFrames;
+        RateDeliveredFrames = Counters.DeliveredFrames;
+        RateUploadedFrames = Uploaded;
+    }
+
+    FAndroidCamera2LatencyHistogram& GetLatency(EAndroidCamera2LatencyStage Stage)
+    {
+        return Latency[static_cast<int32>(Stage)];
+    }
+
+    void AddSpan(EAndroidCamera2LatencyStage Stage, const FAndroidCamera2FrameTimes& Times, EAndroidCamera2FrameStage From, EAndroidCamera2FrameStage To)
+    {
+        if (const uint64 Span = Times.Span(From, To))
+        {
+            GetLatency(Stage).AddSampleCycles(Span);
+        }
     }
 
     void UnblockJavaBuffers()
     {
         bOnRenderQueued = false;
 #if PLATFORM_ANDROID
+        if (Replay)
+            return; // el fichero mapeado no se bloquea
        
         AndroidCamera2Java->ReleaseLastPreviewFrameInfo();
 #endif
@@ -160,6 +534,8 @@ public:
 
     bool GetInitilizedCamaraState() const
     {
+        if (Replay)
+            return true;
 #if PLATFORM_ANDROID
         return AndroidCamera2Java->GetInitilizedCamaraState();
 #endif
@@ -168,7 +544,7 @@ public:
 
     void ReleaseCamera()
     {
-        
+        StopReplay();
 #if PLATFORM_ANDROID
         AndroidCamera2Java->Release();
 #endif
@@ -217,6 +593,9 @@ public:
     bool InitializeCamera(const FString& CameraId, EAndroidCamera2AEMode AEMode, EAndroidCamera2AFMode AFMode, EAndroidCamera2AWBMode AWBMode, EAndroidCamera2ControlMode ControlMode,
         EAndroidCamera2RotationMode RotMode, int32 previewWidth, int32 previewHeight, int32 targetFPS)
     {
+        StopReplay();
+        ResetFrameCounters();
+        TargetFps = targetFPS;
 #if PLATFORM_ANDROID
         AndroidCamera2Java->Release();
         return AndroidCamera2Java->InitializeCamera(
@@ -322,10 +701,30 @@ void UAndroidCamera2Subsystem::Initialize(FSubsystemCollectionBase& Collection)
     AndroidCamera2->bRenderVRT = (v_RT2D != nullptr) && AC2Settings->RenderTargetDataVPlane.bRender;
 
 	CameraTimeout = AC2Settings->CameraTimeOut;
+
+    bSceneChangeDetection = AC2Settings->bSceneChangeDetection;
+    bSkipUploadOnStaticScene = bSceneChangeDetection && AC2Settings->bSkipUploadOnStaticScene;
+    SceneChangeThreshold = AC2Settings->SceneChangeThreshold;
+    SceneChangeDownsample = AC2Settings->SceneChangeDownsample;
+    SceneChangeMaxStaticFrames = AC2Settings->SceneChangeMaxStaticFrames;
+
+    bRecordTelemetry = AC2Settings->bRecordTelemetry;
+
+    AndroidCamera2->ZeroShutterLag.Configure(AC2Settings->ZeroShutterLagFrames);
+    AndroidCamera2->ImageSaver->Configure(AC2Settings->ImageSaveMaxInFlight);
+
+    // Ventana de percentiles: 10 slices
+    for (FAndroidCamera2LatencyHistogram& Histogram : AndroidCamera2->Latency)
+    {
+        Histogram.Configure(AC2Settings->LatencyWindowSeconds, 10);
+        Histogram.SetSpikeThreshold(2.0);
+    }
 }
 
 void UAndroidCamera2Subsystem::Deinitialize()
 {
+    AndroidCamera2->Telemetry.StopRecording();
+    AndroidCamera2->FrameRecorder.StopRecording();
 	AndroidCamera2->ReleaseCamera();
 
 }
@@ -434,6 +833,18 @@ void UAndroidCamera2Subsystem::StopCamera()
         AndroidCamera2->ReleaseCamera();
     }	
     CameraState = EAndroidCamera2State::OFF;
+    AndroidCamera2->Telemetry.StopRecording();
+    AndroidCamera2->FrameRecorder.StopRecording();
+    AndroidCamera2->CancelPendingFrameSaves();
+    if (bPhotoRequested)
+    {
+        // El JPEG ya no llegará: notificar como en el timeout. Una decodificación en curso
+        // (bPhotoDecoding) termina igualmente y se notifica desde el worker.
+        bPhotoRequested = false;
+        FAndroidCamera2Photo Photo;
+        TArray64<uint8> BGRA;
+        OnPhotoDecoded(Photo, BGRA);
+    }
 
     
     if (ClockSink.IsValid())
@@ -476,8 +887,32 @@ void UAndroidCamera2Subsystem::TickFetch(FTimespan DeltaTime)
 	case EAndroidCamera2State::INITIALIZED: // Initialized
        
         AndroidCamera2->GetLastFrameInfo();
+        UpdatePhoto(DeltaTime.GetTotalSeconds());
+        UpdateSceneChange();
         UpdateRenderTextures();
-       
+        AndroidCamera2->UpdateFrameRates();
+
+        SET_FLOAT_STAT(STAT_SensorFps, AndroidCamera2->Counters.SensorFps);
+        SET_FLOAT_STAT(STAT_DeliveredFps, AndroidCamera2->Counters.DeliveredFps);
+        SET_FLOAT_STAT(STAT_UploadedFps, AndroidCamera2->Counters.UploadedFps);
+        SET_DWORD_STAT(STAT_DroppedInReader, AndroidCamera2->Counters.DroppedInReader);
+        SET_DWORD_STAT(STAT_DroppedDrain, AndroidCamera2->Counters.DroppedDrain);
+        SET_DWORD_STAT(STAT_DroppedBusy, AndroidCamera2->Counters.DroppedBusy);
+        SET_DWORD_STAT(STAT_DroppedBeforeFetch, AndroidCamera2->Counters.DroppedBeforeFetch);
+        SET_DWORD_STAT(STAT_ReusedFrames, AndroidCamera2->Counters.ReusedFrames);
+#if STATS
+        if (AndroidCamera2->FrameRecorder.IsRecording())
+        {
+            const FAndroidCamera2RecordingStats RecordingStats = AndroidCamera2->FrameRecorder.GetStats();
+            SET_DWORD_STAT(STAT_RecordedFrames, RecordingStats.RecordedFrames);
+            SET_DWORD_STAT(STAT_RecorderDroppedFrames, RecordingStats.DroppedFrames);
+            SET_FLOAT_STAT(STAT_RecorderEncodeMs, RecordingStats.EncodeMs);
+        }
+        if (AndroidCamera2->Replay && AndroidCamera2->Replay->IsCompressed())
+        {
+            SET_FLOAT_STAT(STAT_ReplayDecodeMs, AndroidCamera2->Replay->GetDecodeMsPerFrame());
+        }
+#endif
         break;
 
     default:
@@ -486,13 +921,15 @@ void UAndroidCamera2Subsystem::TickFetch(FTimespan DeltaTime)
 
 	const uint64 T1 = FPlatformTime::Cycles64();
 
-    static FRollingSpikeCounter GT_W1s(1.0, 10);   // 10 buckets de 100 ms
-
-    const bool bSpike =  FPlatformTime::ToMilliseconds64(T1 - T0) > 2.0f;
-
-    GT_W1s.AddSample(bSpike, T0);
-    SET_FLOAT_STAT(STAT_MediaTickFetchCPUSpikesPct_1s, GT_W1s.GetPercent());
-    
+    AndroidCamera2->GetLatency(EAndroidCamera2LatencyStage::GameThreadFetch).AddSampleCycles(T1 - T0);
+    if (AndroidCamera2->Telemetry.IsRecording())
+    {
+        AndroidCamera2->RecordTelemetry(T1 - T0);
+    }
+    SET_FLOAT_STAT(STAT_MediaTickFetchCPUSpikesPct_1s, 100.f * AndroidCamera2->GetLatency(EAndroidCamera2LatencyStage::GameThreadFetch).GetSpikeFraction(1.0));
+    SET_LATENCY_STATS(AndroidCamera2->GetLatency(EAndroidCamera2LatencyStage::GameThreadFetch), STAT_LatencyGT);
+    SET_LATENCY_STATS(AndroidCamera2->GetLatency(EAndroidCamera2LatencyStage::JavaConversion), STAT_LatencyJava);
+    SET_LATENCY_STATS(AndroidCamera2->GetLatency(EAndroidCamera2LatencyStage::SensorToFetch), STAT_LatencyS2F);
 }
 
 TArray<FString> UAndroidCamera2Subsystem::GetCameraIdList()
@@ -500,7 +937,290 @@ TArray<FString> UAndroidCamera2Subsystem::GetCameraIdList()
     return AndroidCamera2->GetCameraIdList();
 }
 
+FAndroidCamera2LatencyStats UAndroidCamera2Subsystem::GetLatencyStats(EAndroidCamera2LatencyStage Stage, float WindowSeconds) const
+{
+    if (Stage >= EAndroidCamera2LatencyStage::Count)
+    {
+        return FAndroidCamera2LatencyStats();
+    }
+    return AndroidCamera2->GetLatency(Stage).GetStats(WindowSeconds);
+}
+
+FAndroidCamera2FrameCounters UAndroidCamera2Subsystem::GetFrameCounters() const
+{
+    FAndroidCamera2FrameCounters Counters = AndroidCamera2->Counters;
+    Counters.UploadedFrames = AndroidCamera2->UploadedFrames.load(std::memory_order_relaxed);
+    return Counters;
+}
+
+const FAndroidCamera2FrameTimes& UAndroidCamera2Subsystem::GetLastFrameTimes() const
+{
+    return AndroidCamera2->FrameTimes;
+}
+
+void UAndroidCamera2Subsystem::ReportQRDecoded(const FAndroidCamera2FrameTimes& Frame, double DecodeMs)
+{
+    FAndroidCamera2FrameTimes Times = Frame;
+    Times.Mark(EAndroidCamera2FrameStage::QRDecoded);
+    AndroidCamera2->AddSpan(EAndroidCamera2LatencyStage::SensorToQRDecode, Times, EAndroidCamera2FrameStage::SensorExposure, EAndroidCamera2FrameStage::QRDecoded);
+    SET_LATENCY_STATS(AndroidCamera2->GetLatency(EAndroidCamera2LatencyStage::SensorToQRDecode), STAT_LatencyS2QR);
+
+    if (FAndroidCamera2TelemetryRecord* Record = AndroidCamera2->Telemetry.Find(Times.Sequence))
+    {
+        Record->QRDecodedUs = FAndroidCamera2TelemetryRecorder::StageUs(Times, EAndroidCamera2FrameStage::QRDecoded);
+        Record->QRDecodeUs = static_cast<uint32>(FMath::Max(0.0, DecodeMs) * 1000.0);
+        AndroidCamera2->Telemetry.Commit(Record);
+    }
+}
+
+bool UAndroidCamera2Subsystem::StartTelemetry(const FString& FileName)
+{
+    const UAndroidCamera2Settings* AC2Settings = GetDefault<UAndroidCamera2Settings>();
+    const bool bBinary = AC2Settings->TelemetryFormat == EAndroidCamera2TelemetryFormat::Binary;
+
+    FString Name = FileName.IsEmpty() ? FString::Printf(TEXT("Telemetry_%s"), *FDateTime::Now().ToString()) : FileName;
+    if (FPaths::GetExtension(Name).IsEmpty())
+    {
+        Name += bBinary ? TEXT(".bin") : TEXT(".csv");
+    }
+    const FString FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AndroidCamera2"), Name);
+
+    return AndroidCamera2->Telemetry.StartRecording(FilePath, AC2Settings->TelemetryFormat, AC2Settings->TelemetryRingSize);
+}
+
+void UAndroidCamera2Subsystem::StopTelemetry()
+{
+    AndroidCamera2->Telemetry.StopRecording();
+}
+
+bool UAndroidCamera2Subsystem::IsTelemetryRecording() const
+{
+    return AndroidCamera2->Telemetry.IsRecording();
+}
+
+FString UAndroidCamera2Subsystem::GetTelemetryFilePath() const
+{
+    return AndroidCamera2->Telemetry.IsRecording() ? AndroidCamera2->Telemetry.GetFilePath() : FString();
+}
+
+bool UAndroidCamera2Subsystem::StartFrameRecording(const FString& FileName)
+{
+    const UAndroidCamera2Settings* AC2Settings = GetDefault<UAndroidCamera2Settings>();
+    const bool bLossless = AC2Settings->FrameRecordingFormat == EAndroidCamera2RecordingFormat::Lossless;
+
+    FString Name = FileName.IsEmpty() ? FString::Printf(TEXT("Frames_%s"), *FDateTime::Now().ToString()) : FileName;
+    if (FPaths::GetExtension(Name).IsEmpty())
+    {
+        Name += bLossless ? TEXT(".ac2l") : TEXT(".y4m");
+    }
+    const FString FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AndroidCamera2"), Name);
+
+    return AndroidCamera2->FrameRecorder.StartRecording(FilePath, AndroidCamera2->TargetFps, AC2Settings->FrameRecordingQueueDepth, AC2Settings->FrameRecordingFormat);
+}
+
+void UAndroidCamera2Subsystem::StopFrameRecording()
+{
+    AndroidCamera2->FrameRecorder.StopRecording();
+}
+
+FAndroidCamera2RecordingStats UAndroidCamera2Subsystem::GetFrameRecordingStats() const
+{
+    return AndroidCamera2->FrameRecorder.GetStats();
+}
+
+
+
+bool UAndroidCamera2Subsystem::TakePhoto(bool bCreateTexture)
+{
+#if PLATFORM_ANDROID
+    if (CameraState != EAndroidCamera2State::INITIALIZED || AndroidCamera2->Replay || IsPhotoPending())
+    {
+        return false;
+    }
+
+    // El decoder corre en un worker: cargar el módulo aquí, en el GameThread.
+    FModuleManager::LoadModuleChecked<IImageWrapperModule>("ImageWrapper");
+
+    // Solo cuenta un JPEG posterior a esta llamada
+    PhotoJpegSequence = AndroidCamera2->AndroidCamera2Java->GetLastJpegSequence();
+    if (!AndroidCamera2->AndroidCamera2Java->TakePhoto())
+    {
+        return false;
+    }
+    bPhotoRequested = true;
+    bPhotoTexture = bCreateTexture;
+    PhotoTimeLeft = CameraTimeout;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void UAndroidCamera2Subsystem::UpdatePhoto(float DeltaSeconds)
+{
+#if PLATFORM_ANDROID
+    if (!bPhotoRequested || bPhotoDecoding)
+        return;
+
+    TSharedPtr<FAndroidCamera2Java, ESPMode::ThreadSafe> Java = AndroidCamera2->AndroidCamera2Java;
+    const uint8* Jpeg = nullptr;
+    int32 JpegSize = 0;
+    uint64 Sequence = 0;
+    if (Java->GetLastJpegSequence() <= PhotoJpegSequence || !Java->LockLastJpeg(Jpeg, JpegSize, Sequence))
+    {
+        PhotoTimeLeft -= DeltaSeconds;
+        if (PhotoTimeLeft <= 0.f)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("UAndroidCamera2Subsystem::UpdatePhoto::No llegó el JPEG en %.1f s"), CameraTimeout);
+            bPhotoRequested = false;
+            FAndroidCamera2Photo Photo;
+            TArray64<uint8> BGRA;
+            OnPhotoDecoded(Photo, BGRA);
+        }
+        return;
+    }
+
+    bPhotoRequested = false;
+    bPhotoDecoding = true;
+    PhotoJpegSequence = Sequence;
+
+    // Java no sobrescribe el buffer bloqueado (la siguiente foto va al otro): se decodifica sin copiarlo.
+    // El worker retiene Java para que el buffer sobreviva a un StopCamera / Deinitialize.
+    IImageWrapperModule* ImageWrapperModule = &FModuleManager::GetModuleChecked<IImageWrapperModule>("ImageWrapper");
+    const bool bTexture = bPhotoTexture;
+    TWeakObjectPtr<UAndroidCamera2Subsystem> WeakThis(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [Java, ImageWrapperModule, Jpeg, JpegSize, Sequence, bTexture, WeakThis]()
+    {
+        TSharedRef<FAndroidCamera2Photo> Photo = MakeShared<FAndroidCamera2Photo>();
+        TSharedRef<TArray64<uint8>> BGRA = MakeShared<TArray64<uint8>>();
+        Photo->bValid = FAndroidCamera2PhotoDecoder::Decode(*ImageWrapperModule, Jpeg, JpegSize, *Photo, bTexture ? &BGRA.Get() : nullptr);
+        Photo->Sequence = static_cast<int64>(Sequence);
+        Photo->JpegBytes = JpegSize;
+        Java->ReleaseLastJpeg();
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Photo, BGRA]()
+        {
+            if (UAndroidCamera2Subsystem* This = WeakThis.Get())
+            {
+                This->OnPhotoDecoded(*Photo, *BGRA);
+            }
+        });
+    });
+#endif
+}
+
+void UAndroidCamera2Subsystem::OnPhotoDecoded(FAndroidCamera2Photo& Photo, TArray64<uint8>& BGRA)
+{
+    bPhotoDecoding = false;
+    SET_FLOAT_STAT(STAT_PhotoDecodeMs, Photo.DecodeMs);
+
+    if (Photo.bValid && BGRA.Num() == static_cast<int64>(Photo.Width) * Photo.Height * 4)
+    {
+        Photo.Texture = UTexture2D::CreateTransient(Photo.Width, Photo.Height, PF_B8G8R8A8);
+        if (Photo.Texture)
+        {
+            FTexture2DMipMap& Mip = Photo.Texture->GetPlatformData()->Mips[0];
+            FMemory::Memcpy(Mip.BulkData.Lock(LOCK_READ_WRITE), BGRA.GetData(), BGRA.Num());
+            Mip.BulkData.Unlock();
+            Photo.Texture->UpdateResource();
+        }
+        BGRA.Empty();
+    }
+
+    OnPhotoCaptured.Broadcast(Photo);
+}
+
+bool UAndroidCamera2Subsystem::CaptureZeroShutterLag(FAndroidCamera2Photo& OutPhoto, float SecondsAgo, int32 SharpestOfLast) const
+{
+    OutPhoto = FAndroidCamera2Photo();
+    const uint64 Now = FPlatformTime::Cycles64();
+    const uint64 Back = FPlatformTime::SecondsToCycles64(FMath::Max(0.f, SecondsAgo));
+    return AndroidCamera2->ZeroShutterLag.Capture(Now > Back ? Now - Back : 0, SharpestOfLast, OutPhoto);
+}
+
+FString UAndroidCamera2Subsystem::MakeImagePath(const FString& FileName, const TCHAR* DefaultPrefix, EAndroidCamera2ImageFormat Format)
+{
+    FString Name = FileName.IsEmpty()
+        ? FString::Printf(TEXT("%s_%s_%d"), DefaultPrefix, *FDateTime::Now().ToString(TEXT("%Y.%m.%d-%H.%M.%S.%s")), ++ImageSaveCounter)
+        : FileName;
+    if (FPaths::GetExtension(Name).IsEmpty())
+    {
+        Name += (Format == EAndroidCamera2ImageFormat::PNG) ? TEXT(".png") : TEXT(".jpg");
+    }
+    return FPaths::IsRelative(Name) ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AndroidCamera2"), Name) : Name;
+}
+
+static FAndroidCamera2ImageSaver::FOnSaved MakeImageSavedCallback(UAndroidCamera2Subsystem* Subsystem)
+{
+    TWeakObjectPtr<UAndroidCamera2Subsystem> WeakSubsystem(Subsystem);
+    return [WeakSubsystem](bool bSuccess, const FString& FilePath)
+    {
+        if (UAndroidCamera2Subsystem* This = WeakSubsystem.Get())
+        {
+            This->OnImageSaved.Broadcast(bSuccess, FilePath);
+        }
+    };
+}
+
+bool UAndroidCamera2Subsystem::SaveNextFrame(const FString& FileName, EAndroidCamera2ImageFormat Format, int32 Quality)
+{
+    if (CameraState != EAndroidCamera2State::INITIALIZED || !AndroidCamera2->ImageSaver->CanSave(AndroidCamera2->PendingFrameSaves.Num()))
+    {
+        return false;
+    }
 
+    AndroidCamera2->PendingFrameSaves.Add({ MakeImagePath(FileName, TEXT("Frame"), Format), Format, Quality, MakeImageSavedCallback(this) });
+    return true;
+}
+
+bool UAndroidCamera2Subsystem::SavePhoto(const FAndroidCamera2Photo& Photo, const FString& FileName, EAndroidCamera2ImageFormat Format, int32 Quality)
+{
+    if (!Photo.bValid || !AndroidCamera2->ImageSaver->CanSave(AndroidCamera2->PendingFrameSaves.Num()))
+    {
+        return false;
+    }
+
+    return AndroidCamera2->ImageSaver->Save(Photo.Y.GetData(), Photo.U.GetData(), Photo.V.GetData(), Photo.Width, Photo.Height,
+        MakeImagePath(FileName, TEXT("Photo"), Format), Format, Quality, MakeImageSavedCallback(this));
+}
+
+int32 UAndroidCamera2Subsystem::GetImageSavesInFlight() const
+{
+    return AndroidCamera2->ImageSaver->GetInFlight() + AndroidCamera2->PendingFrameSaves.Num();
+}
+
+float UAndroidCamera2Subsystem::GetSceneChangeScore() const
+{
+    return AndroidCamera2->SceneChange.GetScore();
+}
+
+bool UAndroidCamera2Subsystem::IsSceneStatic() const
+{
+    return bSceneChangeDetection && AndroidCamera2->SceneChange.IsStatic();
+}
+
+void UAndroidCamera2Subsystem::UpdateSceneChange()
+{
+    if (!bSceneChangeDetection || AndroidCamera2->TimeStampCycles64 == SceneScoredTimestamp)
+        return;
+
+    SCOPE_CYCLE_COUNTER(STAT_SceneChange_GT);
+
+    // YBuffer es la copia estable; sin ella, el buffer Java (bloqueado hasta el upload).
+    const uint8* Luma = AndroidCamera2->YBuffer.Num() > 0 ? AndroidCamera2->YBuffer.GetData()
+                                                          : static_cast<const uint8*>(AndroidCamera2->yJavaBuffer);
+    if (!Luma || AndroidCamera2->Width <= 0 || AndroidCamera2->Height <= 0)
+        return;
+
+    SceneScoredTimestamp = AndroidCamera2->TimeStampCycles64;
+    if (AndroidCamera2->SceneChange.Update(Luma, AndroidCamera2->Width, AndroidCamera2->Height, AndroidCamera2->Width,
+                                           SceneChangeDownsample, SceneChangeThreshold, SceneChangeMaxStaticFrames))
+    {
+        LastSceneChangeTimestamp = SceneScoredTimestamp;
+    }
+
+    SET_FLOAT_STAT(STAT_SceneChangeScore, AndroidCamera2->SceneChange.GetScore());
+}
 
 void UAndroidCamera2Subsystem::UpdateRenderTextures()
 {
@@ -509,6 +1229,25 @@ void UAndroidCamera2Subsystem::UpdateRenderTextures()
     if (AndroidCamera2->bOnRenderQueued)
         return;
 
+    if (bSkipUploadOnStaticScene)
+    {
+        // Frame casi idéntico al último con cambios: las texturas ya lo muestran.
+        const bool bSkip = AndroidCamera2->SceneChange.IsStatic();
+        AndroidCamera2->UploadSkipped.AddSample(bSkip, FPlatformTime::Cycles64());
+        SET_FLOAT_STAT(STAT_UploadSkippedPct_1s, AndroidCamera2->UploadSkipped.GetPercent());
+
+        if (bSkip)
+        {
+            if (AndroidCamera2->FrameTimes.Sequence != AndroidCamera2->LastSkippedSequence)
+            {
+                AndroidCamera2->LastSkippedSequence = AndroidCamera2->FrameTimes.Sequence;
+                ++AndroidCamera2->Counters.SkippedStaticUploads;
+            }
+            AndroidCamera2->UnblockJavaBuffers();
+            return;
+        }
+    }
+
     const bool bDoY = (IsValid(y_RT2D) && AndroidCamera2->bRenderYRT && AndroidCamera2->yJavaBuffer && AndroidCamera2->Width > 0 && AndroidCamera2->Height > 0);
     const bool bDoU = (IsValid(u_RT2D) && AndroidCamera2->bRenderURT && AndroidCamera2->uJavaBuffer && AndroidCamera2->Width > 0 && AndroidCamera2->Height > 0);
     const bool bDoV = (IsValid(v_RT2D) && AndroidCamera2->bRenderVRT && AndroidCamera2->vJavaBuffer && AndroidCamera2->Width > 0 && AndroidCamera2->Height > 0);
@@ -524,45 +1263,77 @@ void UAndroidCamera2Subsystem::UpdateRenderTextures()
 
     if (RTResY == nullptr && RTResU == nullptr && RTResV == nullptr)
     {
+        // Ningún RT vivo: no hay subida que encolar ni que contar.
         AndroidCamera2->UnblockJavaBuffers();
+        return;
     }
 
     const uint8* YPtr = static_cast<const uint8*>(AndroidCamera2->yJavaBuffer);
     const uint8* UPtr = static_cast<const uint8*>(AndroidCamera2->uJavaBuffer);
     const uint8* VPtr = static_cast<const uint8*>(AndroidCamera2->vJavaBuffer);
 
+    // Si el mismo frame se vuelve a subir, solo la primera subida cuenta para el trazado.
+    const bool bTraceFrame = AndroidCamera2->FrameTimes.Sequence != 0 && AndroidCamera2->FrameTimes.Get(EAndroidCamera2FrameStage::RenderEnqueue) == 0;
+    if (bTraceFrame)
+    {
+        AndroidCamera2->FrameTimes.Mark(EAndroidCamera2FrameStage::RenderEnqueue);
+    }
+
     AndroidCamera2->bOnRenderQueued = true;
     ENQUEUE_RENDER_COMMAND(UploadI420_All)(
-        [AndroidCam2 = AndroidCamera2, RTResY, RTResU, RTResV, YPtr, UPtr, VPtr, W = AndroidCamera2->Width, H = AndroidCamera2->Height](FRHICommandListImmediate& RHICmd)
+        [AndroidCam2 = AndroidCamera2, RTResY, RTResU, RTResV, YPtr, UPtr, VPtr, W = AndroidCamera2->Width, H = AndroidCamera2->Height,
+         bTraceFrame, FrameTimes = AndroidCamera2->FrameTimes](FRHICommandListImmediate& RHICmd) mutable
         {
             SCOPE_CYCLE_COUNTER(STAT_UploadI420_TickFetch_RT);
 
             const uint64 T0 = FPlatformTime::Cycles64();
 
+            // Solo cuenta como subido si algún plano llegó a un RT vivo.
+            bool bWrote = false;
             if (AndroidCam2->yJavaBuffer)
             {
                 UAndroidCamera2Subsystem::UpdatePlaneTexture_RenderThread(RHICmd, RTResY, YPtr, W, H);
+                bWrote |= RTResY && YPtr;
             }
             
             if (AndroidCam2->uJavaBuffer)
             {
                 UAndroidCamera2Subsystem::UpdatePlaneTexture_RenderThread(RHICmd, RTResU, UPtr, W/ 2, H/ 2);
+                bWrote |= RTResU && UPtr;
             }
             if (AndroidCam2->vJavaBuffer)
             {
                 UAndroidCamera2Subsystem::UpdatePlaneTexture_RenderThread(RHICmd, RTResV, VPtr, W/ 2, H/ 2);
+                bWrote |= RTResV && VPtr;
             }
 
             AndroidCam2->UnblockJavaBuffers();
 
             const uint64 T1 = FPlatformTime::Cycles64();
-            
-            static FRollingSpikeCounter RT_W1s(1.0, 10);   // 10 buckets de 100 ms
 
-            const bool bSpike = FPlatformTime::ToMilliseconds64(T1 - T0) >2.0f;
+            FAndroidCamera2LatencyHistogram& UploadLatency = AndroidCam2->GetLatency(EAndroidCamera2LatencyStage::RenderThreadUpload);
+            UploadLatency.AddSampleCycles(T1 - T0);
+            SET_FLOAT_STAT(STAT_MediaTickFetchGPUSpikesPct_1s, 100.f * UploadLatency.GetSpikeFraction(1.0));
+            SET_LATENCY_STATS(UploadLatency, STAT_LatencyRT);
 
-            RT_W1s.AddSample(bSpike, T0);
-            SET_FLOAT_STAT(STAT_MediaTickFetchGPUSpikesPct_1s, RT_W1s.GetPercent());
+            if (bTraceFrame && bWrote)
+            {
+                AndroidCam2->UploadedFrames.fetch_add(1, std::memory_order_relaxed);
+                FrameTimes.Mark(EAndroidCamera2FrameStage::RenderUploaded, T1);
+                AndroidCam2->AddSpan(EAndroidCamera2LatencyStage::FetchToUpload, FrameTimes, EAndroidCamera2FrameStage::NativeFetch, EAndroidCamera2FrameStage::RenderUploaded);
+                AndroidCam2->AddSpan(EAndroidCamera2LatencyStage::SensorToUpload, FrameTimes, EAndroidCamera2FrameStage::SensorExposure, EAndroidCamera2FrameStage::RenderUploaded);
+                SET_LATENCY_STATS(AndroidCam2->GetLatency(EAndroidCamera2LatencyStage::FetchToUpload), STAT_LatencyF2U);
+                SET_LATENCY_STATS(AndroidCam2->GetLatency(EAndroidCamera2LatencyStage::SensorToUpload), STAT_LatencyS2U);
+
+                if (FAndroidCamera2TelemetryRecord* Record = AndroidCam2->Telemetry.Find(FrameTimes.Sequence))
+                {
+                    Record->RenderEnqueueUs = FAndroidCamera2TelemetryRecorder::StageUs(FrameTimes, EAndroidCamera2FrameStage::RenderEnqueue);
+                    Record->RenderUploadedUs = FAndroidCamera2TelemetryRecorder::StageUs(FrameTimes, EAndroidCamera2FrameStage::RenderUploaded);
+                    Record->RenderUploadUs = FAndroidCamera2TelemetryRecorder::CyclesToUs(T1 - T0);
+                    Record->bUploaded = 1;
+                    AndroidCam2->Telemetry.Commit(Record);
+                }
+            }
         }
         );
 
@@ -582,7 +1353,10 @@ void UAndroidCamera2Subsystem::UpdatePlaneTexture_RenderThread(FRHICommandListIm
 bool UAndroidCamera2Subsystem::InitializeCamera(const FString& CameraId, EAndroidCamera2AEMode AEMode, EAndroidCamera2AFMode AFMode, EAndroidCamera2AWBMode AWBMode, EAndroidCamera2ControlMode ControlMode,
     EAndroidCamera2RotationMode RotMode, int32 previewWidth, int32 previewHeight, int32 targetFPS)
 {
-    
+    // La secuencia de frames vuelve a 1 (y el tamaño puede cambiar): cada sesión de cámara va a su propio fichero.
+    AndroidCamera2->Telemetry.StopRecording();
+    AndroidCamera2->FrameRecorder.StopRecording();
+
     CameraState = AndroidCamera2->InitializeCamera(
         CameraId,AEMode,AFMode,AWBMode,ControlMode,RotMode, previewWidth, previewHeight,  targetFPS) ? EAndroidCamera2State::INITIALIZED : EAndroidCamera2State::FAIL_INIT; // Waiting for Initialization
     CameraTimeLeftAfterInitialization = CameraTimeout;
@@ -590,9 +1364,7 @@ bool UAndroidCamera2Subsystem::InitializeCamera(const FString& CameraId, EAndroi
 
     if (CameraState == EAndroidCamera2State::INITIALIZED)
     {
-        ClockSink = MakeShared<FAndroidCamera2ClockSink, ESPMode::ThreadSafe>(*this);
-        IMediaModule* MediaModule = FModuleManager::LoadModulePtr<IMediaModule>("Media");
-        MediaModule->GetClock().AddSink(ClockSink.ToSharedRef());
+        StartFetching();
     }
 
 	CurrentCameraId = CameraId;
@@ -600,6 +1372,47 @@ bool UAndroidCamera2Subsystem::InitializeCamera(const FString& CameraId, EAndroi
     return CameraState == EAndroidCamera2State::INITIALIZED;
 }
 
+bool UAndroidCamera2Subsystem::InitializeReplay(const FString& FilePath, EAndroidCamera2ReplayPacing Pacing, bool bLoop, int32 RawWidth, int32 RawHeight, float RawFps)
+{
+    StopCamera();
+
+    // Rutas relativas: donde StartFrameRecording deja las grabaciones.
+    const FString FullPath = FPaths::IsRelative(FilePath) ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AndroidCamera2"), FilePath) : FilePath;
+    CameraState = AndroidCamera2->StartReplay(FullPath, Pacing, bLoop, RawWidth, RawHeight, RawFps) ? EAndroidCamera2State::INITIALIZED : EAndroidCamera2State::FAIL_INIT;
+    CameraTimeLeftAfterInitialization = CameraTimeout;
+
+    if (CameraState == EAndroidCamera2State::INITIALIZED)
+    {
+        StartFetching();
+    }
+
+    CurrentCameraId = FullPath;
+
+    return CameraState == EAndroidCamera2State::INITIALIZED;
+}
+
+bool UAndroidCamera2Subsystem::IsReplaying() const
+{
+    return AndroidCamera2->Replay.IsValid();
+}
+
+bool UAndroidCamera2Subsystem::IsReplayFinished() const
+{
+    return AndroidCamera2->Replay.IsValid() && AndroidCamera2->bReplayFinished;
+}
+
+void UAndroidCamera2Subsystem::StartFetching()
+{
+    ClockSink = MakeShared<FAndroidCamera2ClockSink, ESPMode::ThreadSafe>(*this);
+    IMediaModule* MediaModule = FModuleManager::LoadModulePtr<IMediaModule>("Media");
+    MediaModule->GetClock().AddSink(ClockSink.ToSharedRef());
+
+    if (bRecordTelemetry)
+    {
+        StartTelemetry();
+    }
+}
+
 bool UAndroidCamera2Subsystem::GetCameraIntrinsics(FString CameraId, FAndroidCamera2Intrinsics& Intrinsics)
 {
 	return AndroidCamera2->GetIntrinsics(CameraId, Intrinsics);
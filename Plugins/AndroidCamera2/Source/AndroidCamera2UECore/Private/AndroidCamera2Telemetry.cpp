@@ -0,0 +1,319 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+
+#include "AndroidCamera2Telemetry.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/Event.h"
+#include "Misc/Paths.h"
+#include "RenderingThread.h"
+
+namespace AndroidCamera2Telemetry
+{
+	// Un registro se escribe cuando ya hay tantos frames más nuevos: para entonces
+	// el render thread y el QR han terminado con él.
+	static constexpr uint64 FlushLag = 8;
+
+	static constexpr uint32 FlushIntervalMs = 250;
+
+	// Secuencia de un slot mientras un hilo escribe su registro.
+	static constexpr uint64 WritingSequence = MAX_uint64;
+
+	struct FBinaryHeader
+	{
+		ANSICHAR Magic[4] = { 'A', 'C', '2', 'T' };
+		uint32 Version = 1;
+		uint32 RecordSize = sizeof(FAndroidCamera2TelemetryRecord);
+		uint32 Reserved = 0;
+	};
+
+	static const ANSICHAR* CsvHeader =
+		"sequence,exposure_us,java_arrival_us,java_converted_us,native_fetch_us,render_enqueue_us,render_uploaded_us,qr_decoded_us,"
+		"game_thread_us,render_upload_us,java_conversion_us,qr_decode_us,width,height,"
+		"dropped_in_reader,dropped_drain,dropped_busy,dropped_before_fetch,uploaded,skipped_static\n";
+}
+
+FAndroidCamera2TelemetryRecorder::~FAndroidCamera2TelemetryRecorder()
+{
+	StopRecording();
+}
+
+bool FAndroidCamera2TelemetryRecorder::StartRecording(const FString& InFilePath, EAndroidCamera2TelemetryFormat InFormat, int32 RingSize)
+{
+	StopRecording();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(InFilePath));
+	File.Reset(PlatformFile.OpenWrite(*InFilePath));
+	if (!File)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FAndroidCamera2TelemetryRecorder::StartRecording::No se pudo abrir %s"), *InFilePath);
+		return false;
+	}
+
+	// El render thread puede tener todavía un upload del ring anterior en cola.
+	if (Slots.IsValid())
+	{
+		FlushRenderingCommands();
+	}
+
+	FilePath = InFilePath;
+	Format = InFormat;
+	Capacity = FMath::Max(64, RingSize);
+	Slots = MakeUnique<FSlot[]>(Capacity);
+	NewestSequence = 0;
+	NextSequence = 0;
+	OverwrittenRecords = 0;
+	StartCycles = FPlatformTime::Cycles64();
+
+	WriteHeader();
+
+	bStopRequested = false;
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	bRecording = true;
+	Thread = FRunnableThread::Create(this, TEXT("AndroidCamera2Telemetry"), 0, TPri_BelowNormal);
+	if (!Thread)
+	{
+		bRecording = false;
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		WakeEvent = nullptr;
+		File.Reset();
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FAndroidCamera2TelemetryRecorder::StartRecording::%s"), *FilePath);
+	return true;
+}
+
+void FAndroidCamera2TelemetryRecorder::StopRecording()
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	bRecording = false;
+	Stop();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+	File.Reset();
+
+	if (OverwrittenRecords > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FAndroidCamera2TelemetryRecorder::StopRecording::%llu registros sobrescritos antes de escribirse (aumentar TelemetryRingSize)"), OverwrittenRecords);
+	}
+}
+
+void FAndroidCamera2TelemetryRecorder::Stop()
+{
+	bStopRequested = true;
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+uint32 FAndroidCamera2TelemetryRecorder::Run()
+{
+	while (!bStopRequested)
+	{
+		WakeEvent->Wait(AndroidCamera2Telemetry::FlushIntervalMs);
+		Flush(false);
+	}
+	Flush(true);
+	return 0;
+}
+
+uint32 FAndroidCamera2TelemetryRecorder::CyclesToUs(uint64 Cycles)
+{
+	return static_cast<uint32>(FMath::Min(FPlatformTime::ToSeconds64(Cycles) * 1e6, static_cast<double>(MAX_uint32)));
+}
+
+uint32 FAndroidCamera2TelemetryRecorder::StageUs(const FAndroidCamera2FrameTimes& Frame, EAndroidCamera2FrameStage Stage)
+{
+	return CyclesToUs(Frame.Span(EAndroidCamera2FrameStage::SensorExposure, Stage));
+}
+
+FAndroidCamera2TelemetryRecord* FAndroidCamera2TelemetryRecorder::Begin(const FAndroidCamera2FrameTimes& Frame)
+{
+	const uint64 Sequence = Frame.Sequence;
+	if (!IsRecording() || Sequence == 0)
+	{
+		return nullptr;
+	}
+
+	FSlot& Slot = Slots[Sequence % Capacity];
+	LockSlot(Slot, 0);
+
+	FAndroidCamera2TelemetryRecord& Record = Slot.Record;
+	FMemory::Memzero(&Record, sizeof(Record));
+	Record.Sequence = Sequence;
+
+	const uint64 Exposure = Frame.Get(EAndroidCamera2FrameStage::SensorExposure);
+	Record.ExposureUs = (Exposure >= StartCycles) ? CyclesToUs(Exposure - StartCycles) : -static_cast<int64>(CyclesToUs(StartCycles - Exposure));
+	Record.JavaArrivalUs = StageUs(Frame, EAndroidCamera2FrameStage::JavaArrival);
+	Record.JavaConvertedUs = StageUs(Frame, EAndroidCamera2FrameStage::JavaConverted);
+	Record.NativeFetchUs = StageUs(Frame, EAndroidCamera2FrameStage::NativeFetch);
+
+	NewestSequence.store(Sequence, std::memory_order_release);
+	return &Record;
+}
+
+FAndroidCamera2TelemetryRecord* FAndroidCamera2TelemetryRecorder::Find(uint64 Sequence)
+{
+	if (!IsRecording() || Sequence == 0)
+	{
+		return nullptr;
+	}
+
+	FSlot& Slot = Slots[Sequence % Capacity];
+	return LockSlot(Slot, Sequence) ? &Slot.Record : nullptr;
+}
+
+void FAndroidCamera2TelemetryRecorder::Commit(FAndroidCamera2TelemetryRecord* Record)
+{
+	if (Record)
+	{
+		Slots[Record->Sequence % Capacity].Sequence.store(Record->Sequence, std::memory_order_release);
+	}
+}
+
+bool FAndroidCamera2TelemetryRecorder::LockSlot(FSlot& Slot, uint64 ExpectedSequence)
+{
+	using namespace AndroidCamera2Telemetry;
+
+	// Seqlock: mientras la secuencia es WritingSequence el escritor no copia el registro, y
+	// dos etapas (game y render thread) no pueden escribir el mismo registro a la vez.
+	uint64 Current = Slot.Sequence.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		if (Current == WritingSequence)
+		{
+			FPlatformProcess::YieldThread(); // la otra escritura son unos pocos campos
+			Current = Slot.Sequence.load(std::memory_order_relaxed);
+			continue;
+		}
+		if (ExpectedSequence != 0 && Current != ExpectedSequence)
+		{
+			return false; // frame ya sobrescrito en el ring
+		}
+		if (Slot.Sequence.compare_exchange_weak(Current, WritingSequence, std::memory_order_acquire, std::memory_order_relaxed))
+		{
+			std::atomic_thread_fence(std::memory_order_release);
+			return true;
+		}
+	}
+}
+
+void FAndroidCamera2TelemetryRecorder::Flush(bool bAll)
+{
+	using namespace AndroidCamera2Telemetry;
+
+	const uint64 Newest = NewestSequence.load(std::memory_order_acquire);
+	if (Newest == 0)
+	{
+		return;
+	}
+
+	if (NextSequence == 0 || Newest >= NextSequence + Capacity)
+	{
+		// Primer frame grabado, o el ring dio la vuelta antes de escribir.
+		const uint64 Oldest = (Newest >= static_cast<uint64>(Capacity)) ? Newest - Capacity + 1 : 1;
+		if (NextSequence != 0)
+		{
+			OverwrittenRecords += Oldest - NextSequence;
+		}
+		NextSequence = FMath::Max(NextSequence, Oldest);
+	}
+
+	const uint64 Last = bAll ? Newest : (Newest > FlushLag ? Newest - FlushLag : 0);
+	for (; NextSequence <= Last; ++NextSequence)
+	{
+		const FSlot& Slot = Slots[NextSequence % Capacity];
+		FAndroidCamera2TelemetryRecord Copy;
+		uint64 Before;
+		for (;;)
+		{
+			Before = Slot.Sequence.load(std::memory_order_acquire);
+			if (Before == WritingSequence)
+			{
+				FPlatformProcess::YieldThread();
+				continue;
+			}
+			if (Before != NextSequence)
+			{
+				break;
+			}
+
+			FMemory::Memcpy(&Copy, &Slot.Record, sizeof(Copy));
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (Slot.Sequence.load(std::memory_order_relaxed) == NextSequence)
+			{
+				break;
+			}
+			// Una etapa tardía escribió durante la copia: se vuelve a copiar.
+		}
+
+		if (Before != NextSequence)
+		{
+			// Frame no entregado a C++ (hueco en la secuencia) o ya sobrescrito.
+			OverwrittenRecords += (Before > NextSequence) ? 1 : 0;
+			continue;
+		}
+
+		WriteRecord(Copy);
+	}
+
+	if (WriteBuffer.Num() > 0)
+	{
+		File->Write(WriteBuffer.GetData(), WriteBuffer.Num());
+		WriteBuffer.Reset();
+	}
+	if (bAll)
+	{
+		File->Flush();
+	}
+}
+
+void FAndroidCamera2TelemetryRecorder::WriteHeader()
+{
+	using namespace AndroidCamera2Telemetry;
+
+	if (Format == EAndroidCamera2TelemetryFormat::Binary)
+	{
+		const FBinaryHeader Header;
+		File->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+	}
+	else
+	{
+		File->Write(reinterpret_cast<const uint8*>(CsvHeader), FCStringAnsi::Strlen(CsvHeader));
+	}
+}
+
+void FAndroidCamera2TelemetryRecorder::WriteRecord(const FAndroidCamera2TelemetryRecord& Record)
+{
+	if (Format == EAndroidCamera2TelemetryFormat::Binary)
+	{
+		WriteBuffer.Append(reinterpret_cast<const uint8*>(&Record), sizeof(Record));
+		return;
+	}
+
+	ANSICHAR Line[320];
+	const int32 Len = FCStringAnsi::Snprintf(Line, sizeof(Line),
+		"%llu,%lld,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u\n",
+		static_cast<unsigned long long>(Record.Sequence), static_cast<long long>(Record.ExposureUs),
+		Record.JavaArrivalUs, Record.JavaConvertedUs, Record.NativeFetchUs, Record.RenderEnqueueUs, Record.RenderUploadedUs, Record.QRDecodedUs,
+		Record.GameThreadUs, Record.RenderUploadUs, Record.JavaConversionUs, Record.QRDecodeUs,
+		static_cast<uint32>(Record.Width), static_cast<uint32>(Record.Height),
+		Record.DroppedInReader, Record.DroppedDrain, Record.DroppedBusy, Record.DroppedBeforeFetch,
+		static_cast<uint32>(Record.bUploaded), static_cast<uint32>(Record.bSkippedStatic));
+	if (Len > 0)
+	{
+		WriteBuffer.Append(reinterpret_cast<const uint8*>(Line), FMath::Min<int32>(Len, sizeof(Line) - 1));
+	}
+}
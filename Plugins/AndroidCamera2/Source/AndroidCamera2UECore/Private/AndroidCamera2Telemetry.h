@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "AndroidCamera2Settings.h"
+#include "AndroidCamera2FrameTrace.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+class IFileHandle;
+
+/**
+ * One frame of telemetry (80 bytes). Stage times are microseconds after the start
+ * of exposure (0 = stage not reached); durations are microseconds.
+ * The binary format is a header followed by these records as-is.
+ */
+struct FAndroidCamera2TelemetryRecord
+{
+	uint64 Sequence;
+	int64 ExposureUs;			// since the recording started
+	uint32 JavaArrivalUs;
+	uint32 JavaConvertedUs;
+	uint32 NativeFetchUs;
+	uint32 RenderEnqueueUs;		// render thread
+	uint32 RenderUploadedUs;	// render thread
+	uint32 QRDecodedUs;
+	uint32 GameThreadUs;		// TickFetch that delivered the frame
+	uint32 RenderUploadUs;		// render thread
+	uint32 JavaConversionUs;
+	uint32 QRDecodeUs;
+	uint16 Width;
+	uint16 Height;
+	uint32 DroppedInReader;
+	uint32 DroppedDrain;
+	uint32 DroppedBusy;
+	uint32 DroppedBeforeFetch;
+	uint8 bUploaded;			// render thread
+	uint8 bSkippedStatic;
+	uint16 Reserved;
+};
+static_assert(sizeof(FAndroidCamera2TelemetryRecord) == 80, "Telemetry record layout is part of the binary format");
+
+/**
+ * Per-frame telemetry recorder. Frames are written into a ring indexed by
+ * sequence number: the game thread opens the record when the frame is fetched
+ * and each later stage (render thread, QR) fills its own fields. A background
+ * thread appends records a few frames old to a CSV or binary file.
+ *
+ * Every slot is a seqlock: Begin and Find take the slot for writing and the
+ * record must be handed back with Commit, so the file writer never copies a
+ * record while another thread is filling it.
+ *
+ * When not recording every hook is a single relaxed load.
+ */
+class FAndroidCamera2TelemetryRecorder final : public FRunnable
+{
+public:
+	~FAndroidCamera2TelemetryRecorder();
+
+	/** Opens the file and starts the writer thread. Game thread. */
+	bool StartRecording(const FString& FilePath, EAndroidCamera2TelemetryFormat InFormat, int32 RingSize);
+
+	/** Flushes every pending record, closes the file and joins the thread. Game thread. */
+	void StopRecording();
+
+	bool IsRecording() const { return bRecording.load(std::memory_order_relaxed); }
+
+	const FString& GetFilePath() const { return FilePath; }
+
+	/** Opens the record for a newly fetched frame. Game thread. Non-null results must be passed to Commit. */
+	FAndroidCamera2TelemetryRecord* Begin(const FAndroidCamera2FrameTimes& Frame);
+
+	/** Record of a frame still in the ring, or nullptr. Non-null results must be passed to Commit. */
+	FAndroidCamera2TelemetryRecord* Find(uint64 Sequence);
+
+	/** Publishes a record returned by Begin or Find; it must not be touched afterwards. */
+	void Commit(FAndroidCamera2TelemetryRecord* Record);
+
+	/** Microseconds of a stage after the start of exposure (0 if either is missing). */
+	static uint32 StageUs(const FAndroidCamera2FrameTimes& Frame, EAndroidCamera2FrameStage Stage);
+	static uint32 CyclesToUs(uint64 Cycles);
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	struct FSlot
+	{
+		std::atomic<uint64> Sequence{ 0 };
+		FAndroidCamera2TelemetryRecord Record;
+	};
+
+	/** Takes the slot for writing; fails if it no longer holds ExpectedSequence (0 = any). */
+	bool LockSlot(FSlot& Slot, uint64 ExpectedSequence);
+
+	void Flush(bool bAll);
+	void WriteHeader();
+	void WriteRecord(const FAndroidCamera2TelemetryRecord& Record);
+
+	TUniquePtr<FSlot[]> Slots;
+	int32 Capacity = 0;
+
+	std::atomic<bool> bRecording{ false };
+	std::atomic<bool> bStopRequested{ false };
+	std::atomic<uint64> NewestSequence{ 0 };
+	uint64 NextSequence = 0;	// writer thread, 0 = nothing written yet
+	uint64 OverwrittenRecords = 0;	// writer thread
+	uint64 StartCycles = 0;
+
+	EAndroidCamera2TelemetryFormat Format = EAndroidCamera2TelemetryFormat::Csv;
+	FString FilePath;
+	TUniquePtr<IFileHandle> File;
+	TArray<uint8> WriteBuffer;
+
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+};
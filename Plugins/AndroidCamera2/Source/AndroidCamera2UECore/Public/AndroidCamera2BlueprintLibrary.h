@@ -3,6 +3,10 @@
 #pragma once
 
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "AndroidCamera2LatencyHistogram.h"
+#include "AndroidCamera2FrameTrace.h"
+#include "AndroidCamera2FrameRecorder.h"
+#include "AndroidCamera2Photo.h"
 #include "AndroidCamera2BlueprintLibrary.generated.h"
 
 class UTextureRenderTarget2D;
@@ -24,6 +28,14 @@ public:
 	static bool InitializeCamera(const FString& CameraId, EAndroidCamera2AEMode AEMode, EAndroidCamera2AFMode AFMode, EAndroidCamera2AWBMode AWBMode, EAndroidCamera2ControlMode ControlMode,
 		EAndroidCamera2RotationMode RotMode, int32 previewWidth = 1280, int32 previewHeight = 720, int32 targetFPS =30);
 
+	/** Plays a Y4M, lossless .ac2l or raw I420 recording instead of the camera (relative paths are under Saved/AndroidCamera2). */
+	UFUNCTION(BlueprintCallable, Category = "Android|Camera2", DisplayName = "Initialize Replay (from file)")
+	static bool InitializeReplay(const FString& FilePath, EAndroidCamera2ReplayPacing Pacing, bool bLoop = false,
+		int32 RawWidth = 0, int32 RawHeight = 0, float RawFps = 30.f);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Android|Camera2", DisplayName = "IsReplayFinished")
+	static bool IsReplayFinished();
+
 	
 	UFUNCTION(BlueprintCallable, Category = "Android|Camera2", DisplayName = "StopCapturing")
 	static void StopCapturing();
@@ -43,6 +55,62 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Android|Camera2", DisplayName = "GetCameraLensPose")
 	static bool GetCameraLensPose(FString CameraId, FAndroidCamera2LensPose& LensPose);
 
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Android|Camera2", DisplayName = "GetLatencyStats")
+	static FAndroidCamera2LatencyStats GetLatencyStats(EAndroidCamera2LatencyStage Stage, float WindowSeconds = 0.f);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Android|Camera2", DisplayName = "GetFrameCounters")
+	static FAndroidCamera2FrameCounters GetFrameCounters();
+
+	/** Starts the per-frame telemetry file under Saved/AndroidCamera2 (empty name = Telemetry_<date>). */
+	UFUNCTION(BlueprintCallable, Category = "Android|Camera2", DisplayName = "StartTelemetry")
+	static bool StartTelemetry(const FString& FileName);
+
+	UFUNCTION(BlueprintCallable, Category = "Android|Camera2", DisplayName = "StopTelemetry")
+	static void StopTelemetry();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Android|Camera2", DisplayName = "IsTelemetryRecording")
+	static bool IsTelemetryRecording();
+
+	/** Records every new camera frame to Saved/AndroidCamera2/<FileName> (empty name = Frames_<date>.y4m / .ac2l). */
+	UFUNCTION(BlueprintCallable, Category = "Android|Camera2", DisplayName = "StartFrameRecording")
+	static bool StartFrameRecording(const FString& FileName);
+
+	UFUNCTION(BlueprintCallable, Category = "Android|Camera2", DisplayName = "StopFrameRecording")
+	static void StopFrameRecording();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Android|Camera2", DisplayName = "GetFrameRecordingStats")
+	static FAndroidCamera2RecordingStats GetFrameRecordingStats();
+
+	/** Takes a still photo; bind the subsystem's OnPhotoCaptured to receive the decoded I420 planes (and texture). */
+	UFUNCTION(BlueprintCallable, Category = "Android|Camera2", DisplayName = "TakePhoto")
+	static bool TakePhoto(bool bCreateTexture = false);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Android|Camera2", DisplayName = "IsPhotoPending")
+	static bool IsPhotoPending();
+
+	/** Instant photo from the last preview frames (needs "Preview frames kept for zero shutter lag" > 0). */
+	UFUNCTION(BlueprintCallable, Category = "Android|Camera2", DisplayName = "CaptureZeroShutterLag")
+	static bool CaptureZeroShutterLag(FAndroidCamera2Photo& OutPhoto, float SecondsAgo = 0.f, int32 SharpestOfLast = 1);
+
+	/** Saves the next camera frame as PNG/JPEG in the background; bind the subsystem's OnImageSaved for completion. */
+	UFUNCTION(BlueprintCallable, Category = "Android|Camera2", DisplayName = "SaveNextFrame")
+	static bool SaveNextFrame(const FString& FileName, EAndroidCamera2ImageFormat Format = EAndroidCamera2ImageFormat::JPEG, int32 Quality = 90);
+
+	UFUNCTION(BlueprintCallable, Category = "Android|Camera2", DisplayName = "SavePhoto")
+	static bool SavePhoto(const FAndroidCamera2Photo& Photo, const FString& FileName, EAndroidCamera2ImageFormat Format = EAndroidCamera2ImageFormat::JPEG, int32 Quality = 90);
+
+	UFUNCTION(BlueprintPure, Category = "Android|Camera2",
+		meta = (DisplayName = "ToString (FAndroidCamera2RecordingStats)", CompactNodeTitle = "ToString"))
+	static FString AndroidCamera2RecordingStats_ToString(const FAndroidCamera2RecordingStats& In);
+
+	UFUNCTION(BlueprintPure, Category = "Android|Camera2",
+		meta = (DisplayName = "ToString (FAndroidCamera2Photo)", CompactNodeTitle = "ToString"))
+	static FString AndroidCamera2Photo_ToString(const FAndroidCamera2Photo& In);
+
+	UFUNCTION(BlueprintPure, Category = "Android|Camera2",
+		meta = (DisplayName = "ToString (FAndroidCamera2FrameCounters)", CompactNodeTitle = "ToString"))
+	static FString AndroidCamera2FrameCounters_ToString(const FAndroidCamera2FrameCounters& In);
+
 	UFUNCTION(BlueprintPure, Category = "Android|Camera2",
 		meta = (DisplayName = "ToString (FAndroidCamera2Intrinsics)", CompactNodeTitle = "ToString"))
 	static FString AndroidCamera2Intrinsics_ToString(const FAndroidCamera2Intrinsics& In);
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+#include <atomic>
+#include "AndroidCamera2FrameRecorder.generated.h"
+
+class FRunnableThread;
+class FEvent;
+class IFileHandle;
+class FAndroidCamera2LosslessCodec;
+
+UENUM()
+enum class EAndroidCamera2RecordingFormat : uint8
+{
+	Y4M			UMETA(ToolTip = "Uncompressed, readable by ffmpeg and most video tools"),
+	Lossless	UMETA(ToolTip = "AndroidCamera2 .ac2l: per-plane prediction + Oodle, replayable with InitializeReplay")
+};
+
+USTRUCT(BlueprintType)
+struct FAndroidCamera2RecordingStats
+{
+	GENERATED_BODY()
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	bool bRecording = false;
+	/** Frames written to the file. */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int64 RecordedFrames = 0;
+	/** Frames not recorded because every pooled buffer was waiting for the writer (or the size changed). */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int64 DroppedFrames = 0;
+	/** Frames copied and waiting for the writer thread. */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int32 QueuedFrames = 0;
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int64 BytesWritten = 0;
+	/** Uncompressed I420 bytes / bytes written (1 for Y4M). */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	float CompressionRatio = 1.f;
+	/** Average lossless encode time per frame on the writer thread (0 for Y4M). */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	float EncodeMs = 0.f;
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	FString FilePath;
+
+	FString ToString() const
+	{
+		return FString::Printf(TEXT("Recording: %s, Recorded: %lld, Dropped: %lld, Queued: %d, Written: %.1f MB (%.2fx), Encode: %.2f ms/frame, File: %s"),
+			bRecording ? TEXT("true") : TEXT("false"), RecordedFrames, DroppedFrames, QueuedFrames, BytesWritten / (1024.0 * 1024.0), CompressionRatio, EncodeMs, *FilePath);
+	}
+};
+
+/**
+ * Records the I420 frames delivered by the camera on a background thread, either to
+ * a Y4M file (C420jpeg, progressive) or losslessly compressed (.ac2l, see
+ * FAndroidCamera2LosslessCodec; the strips of each frame are encoded in parallel).
+ *
+ * PushFrame copies the planes into one of QueueDepth pooled buffers and returns;
+ * when every buffer is still waiting for the writer the frame is dropped and
+ * counted, so the caller never waits on disk I/O. Every frame keeps the camera
+ * sequence number and timestamp in microseconds (in Y4M as XSEQ=/XTS= FRAME
+ * parameters, which readers ignore).
+ */
+class ANDROIDCAMERA2UECORE_API FAndroidCamera2FrameRecorder final : public FRunnable
+{
+public:
+	~FAndroidCamera2FrameRecorder();
+
+	/** Opens the file and starts the writer thread. The size is taken from the first frame. Game thread. */
+	bool StartRecording(const FString& FilePath, int32 FramesPerSecond, int32 QueueDepth,
+		EAndroidCamera2RecordingFormat InFormat = EAndroidCamera2RecordingFormat::Y4M);
+
+	/** Writes every queued frame, closes the file and joins the thread. Game thread. */
+	void StopRecording();
+
+	bool IsRecording() const { return bRecording.load(std::memory_order_relaxed); }
+
+	/**
+	 * Queues a copy of the I420 planes (Y is Width x Height, U and V are Width/2 x Height/2,
+	 * tightly packed). Returns false if the frame was dropped. Game thread.
+	 */
+	bool PushFrame(const uint8* Y, const uint8* U, const uint8* V, int32 Width, int32 Height, uint64 Sequence, int64 TimestampUs);
+
+	FAndroidCamera2RecordingStats GetStats() const;
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	struct FQueuedFrame
+	{
+		int32 Buffer = INDEX_NONE;
+		uint64 Sequence = 0;
+		int64 TimestampUs = 0;
+	};
+
+	void WriteQueuedFrames();
+	bool WriteFrame(const FQueuedFrame& Frame, int64& OutBytes);
+
+	TArray<TArray<uint8>> Buffers;
+	TQueue<int32, EQueueMode::Mpsc> FreeBuffers;		// el escritor devuelve, el GameThread toma
+	TQueue<FQueuedFrame, EQueueMode::Spsc> QueuedFrames;	// el GameThread encola, el escritor consume
+	int32 NumBuffers = 0;
+
+	int32 FrameWidth = 0, FrameHeight = 0;	// fijados por el primer frame
+	int32 Fps = 30;
+	EAndroidCamera2RecordingFormat Format = EAndroidCamera2RecordingFormat::Y4M;
+	TUniquePtr<FAndroidCamera2LosslessCodec> Codec;	// hilo escritor
+	TArray<uint8> Payload;							// hilo escritor
+	bool bHeaderWritten = false;			// hilo escritor
+	bool bWarnedSizeChange = false;
+
+	std::atomic<bool> bRecording{ false };
+	std::atomic<bool> bStopRequested{ false };
+	std::atomic<int64> RecordedFrames{ 0 };
+	std::atomic<int64> DroppedFrames{ 0 };
+	std::atomic<int32> InFlight{ 0 };
+	std::atomic<int64> BytesWritten{ 0 };
+	std::atomic<int64> RawBytes{ 0 };
+	std::atomic<int64> EncodedFrames{ 0 };
+	std::atomic<uint64> EncodeCycles{ 0 };
+
+	FString FilePath;
+	TUniquePtr<IFileHandle> File;
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+};
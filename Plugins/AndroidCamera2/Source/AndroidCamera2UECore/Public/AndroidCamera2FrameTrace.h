@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "AndroidCamera2FrameTrace.generated.h"
+
+/** Stages a camera frame goes through, in order. */
+UENUM(BlueprintType)
+enum class EAndroidCamera2FrameStage : uint8
+{
+	SensorExposure,		// sensor start of exposure
+	JavaArrival,		// Camera2UE.onYuvImage entry
+	JavaConverted,		// Camera2UE.packtoI420Lib done
+	NativeFetch,		// frame picked up by TickFetch (game thread)
+	RenderEnqueue,		// Y/U/V upload command enqueued
+	RenderUploaded,		// UpdatePlaneTexture_RenderThread done
+	QRDecoded,			// QR detection service finished with the frame
+	Count UMETA(Hidden)
+};
+
+/**
+ * Where camera frames went during the current session (reset by InitializeCamera).
+ * Sensor >= acquired >= converted >= delivered >= uploaded; every gap is one of the drops.
+ */
+USTRUCT(BlueprintType)
+struct FAndroidCamera2FrameCounters
+{
+	GENERATED_BODY()
+	/** Captures completed by the sensor. */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int64 SensorFrames = 0;
+	/** Captures that never reached the YUV listener (ImageReader full or HAL drop). */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int64 DroppedInReader = 0;
+	/** Older images closed by the listener drain loop (only the newest is converted). */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int64 DroppedDrain = 0;
+	/** Images skipped because C++ was still reading the previous frame. */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int64 DroppedBusy = 0;
+	/** Frames converted to I420 on the Java side. */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int64 ConvertedFrames = 0;
+	/** Converted frames overwritten before TickFetch picked them up. */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int64 DroppedBeforeFetch = 0;
+	/** Frames picked up by TickFetch. */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int64 DeliveredFrames = 0;
+	/** Delivered frames uploaded to the render targets. */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int64 UploadedFrames = 0;
+	/** Delivered frames not uploaded because the scene was static. */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int64 SkippedStaticUploads = 0;
+	/** TickFetch calls without a new frame: the previous one is re-used. */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int64 ReusedFrames = 0;
+
+	/** Rates over the last second. */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	float SensorFps = 0.f;
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	float DeliveredFps = 0.f;
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	float UploadedFps = 0.f;
+
+	FString ToString() const
+	{
+		return FString::Printf(TEXT("Sensor: %lld (%.1f fps), DroppedInReader: %lld, DroppedDrain: %lld, DroppedBusy: %lld, Converted: %lld, DroppedBeforeFetch: %lld, Delivered: %lld (%.1f fps), Uploaded: %lld (%.1f fps), SkippedStatic: %lld, Reused: %lld"),
+			SensorFrames, SensorFps, DroppedInReader, DroppedDrain, DroppedBusy, ConvertedFrames, DroppedBeforeFetch,
+			DeliveredFrames, DeliveredFps, UploadedFrames, UploadedFps, SkippedStaticUploads, ReusedFrames);
+	}
+};
+
+/**
+ * "AndroidCamera2" trace channel. Each stage of each frame is emitted as an
+ * AndroidCamera2.FrameStage event (Sequence, Stage, Cycle). Enable it with
+ * -trace=default,AndroidCamera2 or "Trace.Enable AndroidCamera2".
+ */
+UE_TRACE_CHANNEL_EXTERN(AndroidCamera2Channel, ANDROIDCAMERA2UECORE_API);
+
+/** Stage timestamps (FPlatformTime::Cycles64) of one camera frame; 0 = stage not reached. */
+struct FAndroidCamera2FrameTimes
+{
+	/** Camera2UE frame counter, 1-based and reset when the camera is released. */
+	uint64 Sequence = 0;
+	uint64 Cycles[static_cast<int32>(EAndroidCamera2FrameStage::Count)] = {};
+
+	uint64 Get(EAndroidCamera2FrameStage Stage) const { return Cycles[static_cast<int32>(Stage)]; }
+
+	/** Cycles from one stage to a later one, 0 if either is missing. */
+	uint64 Span(EAndroidCamera2FrameStage From, EAndroidCamera2FrameStage To) const
+	{
+		const uint64 A = Get(From), B = Get(To);
+		return (A != 0 && B > A) ? B - A : 0;
+	}
+
+	/** Stores the stage and emits it on AndroidCamera2Channel. */
+	ANDROIDCAMERA2UECORE_API void Mark(EAndroidCamera2FrameStage Stage, uint64 InCycles);
+	void Mark(EAndroidCamera2FrameStage Stage) { Mark(Stage, FPlatformTime::Cycles64()); }
+};
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+#include "AndroidCamera2LatencyHistogram.generated.h"
+
+UENUM(BlueprintType)
+enum class EAndroidCamera2LatencyStage : uint8
+{
+	GameThreadFetch,	// TickFetch on the game thread
+	RenderThreadUpload,	// Y/U/V texture upload on the render thread
+	JavaConversion,		// YUV_420_888 -> I420 (+ rotation) on the camera thread
+	SensorToFetch,		// start of exposure -> frame picked up by TickFetch
+	FetchToUpload,		// TickFetch -> textures updated on the render thread
+	SensorToUpload,		// start of exposure -> textures updated (camera to screen)
+	SensorToQRDecode,	// start of exposure -> QR detection done
+	Count UMETA(Hidden)
+};
+
+USTRUCT(BlueprintType)
+struct FAndroidCamera2LatencyStats
+{
+	GENERATED_BODY()
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	float P50Ms = 0.f;
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	float P95Ms = 0.f;
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	float P99Ms = 0.f;
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	float MaxMs = 0.f;
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int32 NumSamples = 0;
+
+	FString ToString() const
+	{
+		return FString::Printf(TEXT("p50: %.3f ms, p95: %.3f ms, p99: %.3f ms, max: %.3f ms, samples: %d"),
+			P50Ms, P95Ms, P99Ms, MaxMs, NumSamples);
+	}
+};
+
+/**
+ * Latency histogram over a rolling time window.
+ *
+ * Buckets are log-linear in microseconds: exact below 8 us, then 8 sub-buckets per
+ * power of two (<= 12.5% error) up to 2^26 - 1 us (~67 s). The window is split in slices; the
+ * oldest slice is recycled when time moves on, so memory and cost are fixed.
+ *
+ * AddSample is lock-free and may be called from any thread; queries can run
+ * concurrently with it. A sample that races with the recycling of its slice may
+ * be dropped, which is fine for statistics.
+ */
+class ANDROIDCAMERA2UECORE_API FAndroidCamera2LatencyHistogram
+{
+public:
+	explicit FAndroidCamera2LatencyHistogram(double InWindowSeconds = 1.0, int32 InNumSlices = 10);
+
+	FAndroidCamera2LatencyHistogram(const FAndroidCamera2LatencyHistogram&) = delete;
+	FAndroidCamera2LatencyHistogram& operator=(const FAndroidCamera2LatencyHistogram&) = delete;
+
+	/** Changes the window and clears all samples. Not thread safe: call before recording. */
+	void Configure(double InWindowSeconds, int32 InNumSlices);
+
+	void AddSample(double Milliseconds);
+	void AddSampleCycles(uint64 Cycles);
+
+	/**
+	 * Percentiles over the last WindowSeconds (rounded up to whole slices, clamped
+	 * to the configured window; <= 0 uses the whole window). Percentiles report the
+	 * upper edge of their bucket, never above the exact max.
+	 */
+	FAndroidCamera2LatencyStats GetStats(double WindowSeconds = 0.0) const;
+
+	/**
+	 * Fraction [0,1] of samples above Milliseconds in the window, at bucket resolution:
+	 * only buckets that start above the threshold count (2.0 ms counts from 2.048 ms).
+	 */
+	float GetFractionAbove(double Milliseconds, double WindowSeconds = 0.0) const;
+
+	/** Counts samples strictly above Milliseconds exactly, next to the buckets. Not thread safe: call before recording. */
+	void SetSpikeThreshold(double Milliseconds);
+
+	/** Fraction [0,1] of samples strictly above the spike threshold in the window (0 if none is set). */
+	float GetSpikeFraction(double WindowSeconds = 0.0) const;
+
+	double GetWindowSeconds() const { return WindowSeconds; }
+
+	void Reset();
+
+	static constexpr int32 SubBucketBits = 3;
+	static constexpr int32 SubBuckets = 1 << SubBucketBits;
+	static constexpr int32 MaxExponent = 25;
+	static constexpr int32 NumBuckets = (MaxExponent - SubBucketBits + 2) * SubBuckets;
+
+	static int32 BucketIndex(uint32 Micros);
+	static uint32 BucketLowerMicros(int32 Index);
+	static uint32 BucketUpperMicros(int32 Index);
+
+private:
+	struct FSlice
+	{
+		std::atomic<uint64> Epoch{ MAX_uint64 };
+		std::atomic<uint32> MaxMicros{ 0 };
+		std::atomic<uint32> Spikes{ 0 };
+		std::atomic<uint32> Counts[NumBuckets];
+
+		FSlice();
+		void Clear();
+	};
+
+	uint64 NowEpoch() const;
+	int32 SumWindow(double InWindowSeconds, uint32* OutCounts, uint32& OutMaxMicros, uint32* OutSpikes = nullptr) const;
+
+	double WindowSeconds = 1.0;
+	int32 NumSlices = 10;
+	uint64 SliceCycles = 1;
+	uint32 SpikeMicros = MAX_uint32;	// MAX_uint32 = sin umbral
+	TUniquePtr<FSlice[]> Slices;
+};
@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AndroidCamera2Photo.generated.h"
+
+class UTexture2D;
+
+UENUM(BlueprintType)
+enum class EAndroidCamera2ImageFormat : uint8
+{
+	PNG		UMETA(ToolTip = "Lossless, larger and slower to encode"),
+	JPEG
+};
+
+/**
+ * Still photo: decoded from the camera JPEG (UAndroidCamera2Subsystem::TakePhoto) or copied
+ * from the zero-shutter-lag ring of preview frames (CaptureZeroShutterLag).
+ */
+USTRUCT(BlueprintType)
+struct FAndroidCamera2Photo
+{
+	GENERATED_BODY()
+	/** false if the JPEG could not be decoded (the planes are then empty). */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	bool bValid = false;
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int32 Width = 0;
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int32 Height = 0;
+	/** TakePhoto: still capture sequence, 1 for the first photo since the app started. Zero shutter lag: preview frame sequence. */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int64 Sequence = 0;
+	/** I420 planes, tightly packed: Y is Width x Height, U and V are Width/2 x Height/2. */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	TArray<uint8> Y;
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	TArray<uint8> U;
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	TArray<uint8> V;
+	/** BGRA texture of the photo, only when TakePhoto was asked for one. */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	UTexture2D* Texture = nullptr;
+	/** Size of the JPEG delivered by the camera (0 for zero shutter lag). */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	int32 JpegBytes = 0;
+	/** JPEG decode + I420 conversion on the worker thread. */
+	UPROPERTY(BlueprintReadOnly, Category = "AndroidCamera2")
+	float DecodeMs = 0.f;
+
+	FString ToString() const
+	{
+		return FString::Printf(TEXT("Valid: %s, Size: %dx%d, Sequence: %lld, Jpeg: %.1f KB, Decode: %.1f ms, Texture: %s"),
+			bValid ? TEXT("true") : TEXT("false"), Width, Height, Sequence, JpegBytes / 1024.0, DecodeMs, Texture ? TEXT("true") : TEXT("false"));
+	}
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAndroidCamera2PhotoCaptured, const FAndroidCamera2Photo&, Photo);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAndroidCamera2ImageSaved, bool, bSuccess, const FString&, FilePath);
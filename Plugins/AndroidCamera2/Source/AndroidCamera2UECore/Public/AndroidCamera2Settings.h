@@ -5,8 +5,16 @@
 #include "CoreMinimal.h"
 #include "Engine/DeveloperSettings.h"
 #include "Engine/TextureRenderTarget2D.h"
+#include "AndroidCamera2FrameRecorder.h"
 #include "AndroidCamera2Settings.generated.h"
 
+UENUM()
+enum class EAndroidCamera2TelemetryFormat : uint8
+{
+    Csv,
+    Binary		UMETA(ToolTip = "Header (AC2T, version, record size) followed by fixed 80-byte records")
+};
+
 USTRUCT()
 struct FAndroidCamera2OutputDataSettings
 {
@@ -60,6 +68,56 @@ public:
     UPROPERTY(config, EditAnywhere, Category = "Camera Settings", meta = (DisplayName = "Time Out in seconds of camera after initizialization"))
     float CameraTimeOut = 5.f;
 
+    UPROPERTY(config, EditAnywhere, Category = "Scene Change", meta = (DisplayName = "Compute scene change score",
+        ToolTip = "MSE between a downsampled copy of each frame's luma and the last frame that counted as a change"))
+    bool bSceneChangeDetection = false;
+
+    UPROPERTY(config, EditAnywhere, Category = "Scene Change", meta = (EditCondition = "bSceneChangeDetection", ClampMin = "0.0",
+        ToolTip = "Frames scoring below this MSE count as static"))
+    float SceneChangeThreshold = 4.f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Scene Change", meta = (EditCondition = "bSceneChangeDetection", ClampMin = "1", ClampMax = "16",
+        ToolTip = "Luma is box-downsampled by this factor per axis before comparing"))
+    int32 SceneChangeDownsample = 4;
+
+    UPROPERTY(config, EditAnywhere, Category = "Scene Change", meta = (EditCondition = "bSceneChangeDetection", ClampMin = "0",
+        ToolTip = "Static frames in a row before one is treated as a change anyway (0 = never)"))
+    int32 SceneChangeMaxStaticFrames = 30;
+
+    UPROPERTY(config, EditAnywhere, Category = "Scene Change", meta = (EditCondition = "bSceneChangeDetection",
+        ToolTip = "Skip the Y/U/V render target upload on static frames"))
+    bool bSkipUploadOnStaticScene = true;
+
+    UPROPERTY(config, EditAnywhere, Category = "Stats", meta = (DisplayName = "Latency window in seconds", ClampMin = "0.1", ClampMax = "60.0",
+        ToolTip = "Rolling window of the latency percentiles (p50/p95/p99/max) shown in 'stat AndroidCamera2'. The '>2ms spikes in 1 sec' stats use the last second of it (the whole window when shorter)"))
+    float LatencyWindowSeconds = 1.f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Telemetry", meta = (DisplayName = "Record per-frame telemetry",
+        ToolTip = "Write one record per camera frame (stage timestamps, latencies, size, drops, QR decode time) to Saved/AndroidCamera2 while the camera runs"))
+    bool bRecordTelemetry = false;
+
+    UPROPERTY(config, EditAnywhere, Category = "Telemetry", meta = (EditCondition = "bRecordTelemetry"))
+    EAndroidCamera2TelemetryFormat TelemetryFormat = EAndroidCamera2TelemetryFormat::Csv;
+
+    UPROPERTY(config, EditAnywhere, Category = "Telemetry", meta = (EditCondition = "bRecordTelemetry", ClampMin = "64", ClampMax = "65536",
+        ToolTip = "Frames kept in memory until the writer thread flushes them"))
+    int32 TelemetryRingSize = 1024;
+
+    UPROPERTY(config, EditAnywhere, Category = "Recording", meta = (DisplayName = "Frame recording queue depth", ClampMin = "2", ClampMax = "64",
+        ToolTip = "Pooled frame buffers waiting for the Y4M writer thread; when all are busy new frames are dropped"))
+    int32 FrameRecordingQueueDepth = 8;
+
+    UPROPERTY(config, EditAnywhere, Category = "Recording", meta = (DisplayName = "Frame recording format"))
+    EAndroidCamera2RecordingFormat FrameRecordingFormat = EAndroidCamera2RecordingFormat::Y4M;
+
+    UPROPERTY(config, EditAnywhere, Category = "Recording", meta = (DisplayName = "Image saves in flight", ClampMin = "1", ClampMax = "8",
+        ToolTip = "PNG/JPEG saves (SaveNextFrame, SavePhoto) encoded at the same time in background tasks, each with a pooled buffer; further saves are rejected until one finishes"))
+    int32 ImageSaveMaxInFlight = 2;
+
+    UPROPERTY(config, EditAnywhere, Category = "Zero Shutter Lag", meta = (DisplayName = "Preview frames kept for zero shutter lag", ClampMin = "0", ClampMax = "60",
+        ToolTip = "Last N preview frames kept in pooled memory (Width x Height x 1.5 bytes each) so CaptureZeroShutterLag returns a photo instantly. 0 disables it"))
+    int32 ZeroShutterLagFrames = 0;
+
     UPROPERTY(config, EditAnywhere, Category = "Permissions Meta Quest", meta = (DisplayName = "Request Headset Camera Permission"))
     bool bRequestHeadsetCameraPermission = false;
 };
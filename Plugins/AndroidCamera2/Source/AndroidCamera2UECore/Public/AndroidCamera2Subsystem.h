@@ -6,6 +6,10 @@
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Tickable.h" 
 #include "Templates/SharedPointer.h"
+#include "AndroidCamera2LatencyHistogram.h"
+#include "AndroidCamera2FrameTrace.h"
+#include "AndroidCamera2FrameRecorder.h"
+#include "AndroidCamera2Photo.h"
 
 
 
@@ -85,6 +89,13 @@ enum class EAndroidCamera2RotationMode : uint8
 	RSensor = 4
 };
 
+UENUM(BlueprintType)
+enum class EAndroidCamera2ReplayPacing : uint8
+{
+	RealTime,			// frames follow the file frame rate; slow ticks skip frames
+	AsFastAsPossible	// one new frame per TickFetch, every frame exactly once
+};
+
 USTRUCT(BlueprintType)
 struct FAndroidCamera2Intrinsics
 {
@@ -169,6 +180,22 @@ public:
 	bool InitializeCamera(const FString& CameraId, EAndroidCamera2AEMode AEMode, EAndroidCamera2AFMode AFMode, EAndroidCamera2AWBMode AWBMode, EAndroidCamera2ControlMode ControlMode,
 		EAndroidCamera2RotationMode RotMode, int32 previewWidth = 1280, int32 previewHeight = 720, int32 targetFPS = 30);
 
+	/**
+	 * Plays an I420 recording instead of the camera, through the same buffers and render
+	 * targets (works on every platform). Y4M and lossless .ac2l files carry their size and frame
+	 * rate; any other file is read as raw I420 frames of RawWidth x RawHeight at RawFps. Relative paths are
+	 * resolved against Saved/AndroidCamera2. The file is memory-mapped; Y4M/raw frames are not
+	 * copied except into the buffers enabled in Project Settings, .ac2l frames are decoded in
+	 * parallel. Stopped by StopCamera.
+	 */
+	bool InitializeReplay(const FString& FilePath, EAndroidCamera2ReplayPacing Pacing = EAndroidCamera2ReplayPacing::RealTime, bool bLoop = false,
+		int32 RawWidth = 0, int32 RawHeight = 0, float RawFps = 30.f);
+
+	bool IsReplaying() const;
+
+	/** true once a non-looping replay has delivered its last frame. */
+	bool IsReplayFinished() const;
+
 	
     TArray<FString> GetCameraIdList();
 
@@ -195,6 +222,110 @@ public:
 
 	FString GetCurrentCameraId() const { return CurrentCameraId; };
 
+	/** true if Project Settings > Android Camera2 > Scene Change is enabled. */
+	bool IsSceneChangeDetectionEnabled() const { return bSceneChangeDetection; }
+
+	/** MSE of the last frame against the last frame that counted as a change (downsampled luma). */
+	float GetSceneChangeScore() const;
+
+	/** true if the last frame barely differs from the last frame that counted as a change. */
+	bool IsSceneStatic() const;
+
+	/**
+	 * Timestamp (cycles64, as GetLuminanceBufferPtr) of the last frame above the threshold.
+	 * A consumer that already processed that frame or a later one can skip the current one.
+	 */
+	uint64 GetLastSceneChangeTimestamp() const { return LastSceneChangeTimestamp; }
+
+	/**
+	 * p50/p95/p99/max of one pipeline stage over the last WindowSeconds
+	 * (<= 0 uses the whole window from Project Settings > Android Camera2 > Stats).
+	 */
+	FAndroidCamera2LatencyStats GetLatencyStats(EAndroidCamera2LatencyStage Stage, float WindowSeconds = 0.f) const;
+
+	/** Produced / dropped / delivered / uploaded frame totals and rates for the current session. */
+	FAndroidCamera2FrameCounters GetFrameCounters() const;
+
+	/** Sequence number and stage timestamps of the frame last picked up by TickFetch. */
+	const FAndroidCamera2FrameTimes& GetLastFrameTimes() const;
+
+	/**
+	 * Marks the QRDecoded stage of a frame (as returned by GetLastFrameTimes when it was
+	 * fetched) and feeds the SensorToQRDecode latency.
+	 */
+	void ReportQRDecoded(const FAndroidCamera2FrameTimes& Frame, double DecodeMs = 0.0);
+
+	/**
+	 * Starts writing one record per camera frame to Saved/AndroidCamera2/<FileName>
+	 * (default Telemetry_<date>; .csv or .bin per Project Settings > Android Camera2 > Telemetry).
+	 * Started automatically by InitializeCamera when "Record per-frame telemetry" is on;
+	 * stopped by StopCamera and by the next InitializeCamera.
+	 */
+	bool StartTelemetry(const FString& FileName = FString());
+
+	/** Writes every pending record and closes the telemetry file. */
+	void StopTelemetry();
+
+	bool IsTelemetryRecording() const;
+
+	/** Full path of the telemetry file being written, empty if not recording. */
+	FString GetTelemetryFilePath() const;
+
+	/**
+	 * Starts recording every new camera frame (I420) to Saved/AndroidCamera2/<FileName>
+	 * (default Frames_<date>, .y4m or lossless .ac2l per Project Settings > Recording) on a background thread. Frames that find every pooled
+	 * buffer busy are dropped and counted, TickFetch never waits for the disk.
+	 * Stopped by StopCamera and by the next InitializeCamera.
+	 */
+	bool StartFrameRecording(const FString& FileName = FString());
+
+	/** Writes the queued frames and closes the Y4M file. */
+	void StopFrameRecording();
+
+	FAndroidCamera2RecordingStats GetFrameRecordingStats() const;
+
+	/**
+	 * Takes a still photo (AF lock + AE precapture, then a JPEG). The JPEG is read in place from
+	 * the camera's reusable direct buffer and decoded to I420 on a worker thread; OnPhotoCaptured
+	 * fires on the game thread with the planes, plus a BGRA texture if bCreateTexture.
+	 * false if the camera is not running (or is replaying) or a photo is already in progress.
+	 * If no JPEG arrives within the camera timeout, OnPhotoCaptured fires with bValid false.
+	 */
+	bool TakePhoto(bool bCreateTexture = false);
+
+	/** true from TakePhoto until OnPhotoCaptured. */
+	bool IsPhotoPending() const { return bPhotoRequested || bPhotoDecoding; }
+
+	UPROPERTY(BlueprintAssignable, Category = "AndroidCamera2")
+	FOnAndroidCamera2PhotoCaptured OnPhotoCaptured;
+
+	/**
+	 * Instant photo from the ring of recent preview frames (Project Settings > Android Camera2 >
+	 * Zero Shutter Lag): the frame whose sensor timestamp is closest to SecondsAgo before now or,
+	 * with SharpestOfLast > 1, the sharpest of that frame and the ones just before it. No sensor
+	 * request and no 3A wait; the photo has the preview resolution and no texture.
+	 * false if the ring is disabled or still empty.
+	 */
+	bool CaptureZeroShutterLag(FAndroidCamera2Photo& OutPhoto, float SecondsAgo = 0.f, int32 SharpestOfLast = 1) const;
+
+	/**
+	 * Saves the next camera (or replay) frame to Saved/AndroidCamera2/<FileName> (default Frame_<date>_<n>;
+	 * .png/.jpg added if missing). The frame is copied once into a pooled buffer; RGB conversion
+	 * (libyuv), encoding (IImageWrapper) and the write run on a background task. At most
+	 * "Image saves in flight" (Project Settings > Recording) at a time: false if that many are
+	 * pending. OnImageSaved fires on the game thread when the file is written (or fails).
+	 */
+	bool SaveNextFrame(const FString& FileName = FString(), EAndroidCamera2ImageFormat Format = EAndroidCamera2ImageFormat::JPEG, int32 Quality = 90);
+
+	/** As SaveNextFrame, for a photo from TakePhoto or CaptureZeroShutterLag (default Photo_<date>_<n>). */
+	bool SavePhoto(const FAndroidCamera2Photo& Photo, const FString& FileName = FString(), EAndroidCamera2ImageFormat Format = EAndroidCamera2ImageFormat::JPEG, int32 Quality = 90);
+
+	/** Saves queued or being encoded. */
+	int32 GetImageSavesInFlight() const;
+
+	UPROPERTY(BlueprintAssignable, Category = "AndroidCamera2")
+	FOnAndroidCamera2ImageSaved OnImageSaved;
+
 private:
 	EAndroidCamera2State CameraState = EAndroidCamera2State::OFF;
 
@@ -203,6 +334,25 @@ private:
 	float CameraTimeout = 5.0f; // seconds
 	float CameraTimeLeftAfterInitialization = 5.f;
 
+	bool bSceneChangeDetection = false;
+	bool bSkipUploadOnStaticScene = false;
+	float SceneChangeThreshold = 4.f;
+	int32 SceneChangeDownsample = 4;
+	int32 SceneChangeMaxStaticFrames = 30;
+	uint64 SceneScoredTimestamp = 0;
+	uint64 LastSceneChangeTimestamp = 0;
+
+	bool bRecordTelemetry = false;
+
+	bool bPhotoRequested = false;	// esperando el JPEG
+	bool bPhotoDecoding = false;	// JPEG bloqueado, decodificando en un worker
+	bool bPhotoTexture = false;
+	uint64 PhotoJpegSequence = 0;	// ltimo JPEG ya entregado (o existente al llamar a TakePhoto)
+	float PhotoTimeLeft = 0.f;
+
+	int32 ImageSaveCounter = 0;	// sufijo de los nombres por defecto (rfagas en el mismo milisegundo)
+	FString MakeImagePath(const FString& FileName, const TCHAR* DefaultPrefix, EAndroidCamera2ImageFormat Format);
+
 	UPROPERTY() UTextureRenderTarget2D* y_RT2D = nullptr;
 	UPROPERTY() UTextureRenderTarget2D* u_RT2D = nullptr;
 	UPROPERTY() UTextureRenderTarget2D* v_RT2D = nullptr;
@@ -212,10 +362,18 @@ private:
 
 	TSharedPtr<FAndroidCamera2ClockSink, ESPMode::ThreadSafe> ClockSink;
 
+	void StartFetching();
+
 	UTextureRenderTarget2D* ValidateRenderTarget(TSoftObjectPtr<UTextureRenderTarget2D> RenderTarget2D);
 
 	void UpdateRenderTextures();
 
+	void UpdateSceneChange();
+
+	void UpdatePhoto(float DeltaSeconds);
+
+	void OnPhotoDecoded(FAndroidCamera2Photo& Photo, TArray64<uint8>& BGRA);
+
 	static void UpdatePlaneTexture_RenderThread(FRHICommandListImmediate& RHICmd, FTextureRenderTargetResource* RTRes, const uint8* Src, int32 W, int32 H);
 
 	FString CurrentCameraId ="";
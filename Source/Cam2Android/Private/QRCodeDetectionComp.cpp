@@ -3,18 +3,14 @@
 
 
 #include "QRCodeDetectionComp.h"
-#include "AndroidCamera2Subsystem.h"
 #include "Kismet/GameplayStatics.h" 
 #include "Engine/Engine.h"
 
 // Sets default values for this component's properties
 UQRCodeDetectionComp::UQRCodeDetectionComp()
 {
-	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
-	// off to improve performance if you don't need them.
-	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.TickGroup = TG_PrePhysics;
-	// ...
+	// La decodificación la hace UQRCodeDetectionSubsystem; el componente no necesita tick.
+	PrimaryComponentTick.bCanEverTick = false;
 }
 
 
@@ -23,70 +19,33 @@ void UQRCodeDetectionComp::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// ...
-	
-}
-
-
-// Called every frame
-void UQRCodeDetectionComp::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
-{
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	bool bGotFrame = false;
-	if (UGameInstance* GI = UGameplayStatics::GetGameInstance(GWorld))
+	if (UGameInstance* GI = UGameplayStatics::GetGameInstance(this))
 	{
-		if (auto* Cam2 = GI->GetSubsystem<UAndroidCamera2Subsystem>())
+		if (UQRCodeDetectionSubsystem* QR = GI->GetSubsystem<UQRCodeDetectionSubsystem>())
 		{
-			if (Cam2->GetCameraState() == EAndroidCamera2State::INITIALIZED)
-			{
-				const uint8* YPtr = nullptr;
-				int32 YW = 0, YH = 0;
-				uint64 YTs = 0;
-				if (Cam2->GetLuminanceBufferPtr(YPtr, YW, YH, YTs))
-				{
-					// comprobar dimensiones
-					if (Width != YW || Height != YH || YCurr.Num() != Width * Height)
-					{
-						Width = YW; Height = YH;
-						InitializeLuma(Width, Height);
-					}
-
-					if (YTs <= LastFrameTimestamp)
-					{
-						return;
-					}
-
-					// copiar luminancia
-					FMemory::Memcpy(YCurr.GetData(), YPtr, Width * Height);
-					LastFrameTimestamp = YTs;
-					bGotFrame = true;
-
-					FQuircReader::DecodeFromLuma(YCurr.GetData(), Width, Height, Width, QRDetections);
-
-				}
-			}
+			QR->RegisterListener(this);
+			Service = QR;
 		}
-
 	}
+}
+
 
-	if (bGotFrame == false)
+void UQRCodeDetectionComp::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UQRCodeDetectionSubsystem* QR = Service.Get())
 	{
-		// no hay frame nuevo, salir
-		return;
+		QR->UnregisterListener(this);
 	}
+	Service.Reset();
 
-	if (OnQRCodeDetected.IsBound())
-		OnQRCodeDetected.Broadcast(QRDetections);
+	Super::EndPlay(EndPlayReason);
 }
 
 
-
-void UQRCodeDetectionComp::InitializeLuma(int32 InWidth, int32 InHeight)
+const TArray<FQRDetection>& UQRCodeDetectionComp::GetQRCodesDetected() const
 {
-	check(InWidth > 0 && InHeight > 0);
-	Width = InWidth;
-	Height = InHeight;
+	static const TArray<FQRDetection> Empty;
 
-	YCurr.SetNumZeroed(Width * Height);
-}
\ No newline at end of file
+	const UQRCodeDetectionSubsystem* QR = Service.Get();
+	return QR ? QR->GetQRCodesDetected() : Empty;
+}
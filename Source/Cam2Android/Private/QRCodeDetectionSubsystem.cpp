@@ -0,0 +1,239 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+
+#include "QRCodeDetectionSubsystem.h"
+#include "QRCodeDetectionComp.h"
+#include "AndroidCamera2Subsystem.h"
+#include "Engine/GameInstance.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("QRCodeDetection"), STATGROUP_QRCodeDetection, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("QR Scan - GameThread (CPU)"), STAT_QRScan_GT, STATGROUP_QRCodeDetection);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("QR scans in 1 sec"), STAT_QRScansPerSecond, STATGROUP_QRCodeDetection);
+DECLARE_DWORD_COUNTER_STAT(TEXT("QR scan budget overruns in 1 sec"), STAT_QRBudgetOverruns_1s, STATGROUP_QRCodeDetection);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("QR scan cost [ms/MP]"), STAT_QRScanCostPerMP, STATGROUP_QRCodeDetection);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("QR frames skipped (static scene)"), STAT_QRStaticFramesSkipped, STATGROUP_QRCodeDetection);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("QR decode p50 [ms]"), STAT_LatencyQR_P50, STATGROUP_QRCodeDetection);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("QR decode p95 [ms]"), STAT_LatencyQR_P95, STATGROUP_QRCodeDetection);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("QR decode p99 [ms]"), STAT_LatencyQR_P99, STATGROUP_QRCodeDetection);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("QR decode max [ms]"), STAT_LatencyQR_Max, STATGROUP_QRCodeDetection);
+
+void UQRCodeDetectionSubsystem::Deinitialize()
+{
+	Listeners.Reset();
+	OnQRCodeDetected.Clear();
+	Super::Deinitialize();
+}
+
+ETickableTickType UQRCodeDetectionSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UQRCodeDetectionSubsystem::IsTickable() const
+{
+	return Listeners.Num() > 0 || OnQRCodeDetected.IsBound();
+}
+
+TStatId UQRCodeDetectionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UQRCodeDetectionSubsystem, STATGROUP_Tickables);
+}
+
+void UQRCodeDetectionSubsystem::RegisterListener(UQRCodeDetectionComp* Listener)
+{
+	if (Listener)
+	{
+		Listeners.AddUnique(Listener);
+	}
+}
+
+void UQRCodeDetectionSubsystem::UnregisterListener(UQRCodeDetectionComp* Listener)
+{
+	Listeners.RemoveSingleSwap(Listener);
+}
+
+bool UQRCodeDetectionSubsystem::FetchFrame(const uint8*& OutLuma)
+{
+	UAndroidCamera2Subsystem* Cam2 = GetGameInstance()->GetSubsystem<UAndroidCamera2Subsystem>();
+	if (!Cam2 || Cam2->GetCameraState() != EAndroidCamera2State::INITIALIZED)
+	{
+		return false;
+	}
+
+	int32 YW = 0, YH = 0;
+	uint64 YTs = 0;
+	if (!Cam2->GetLuminanceBufferPtr(OutLuma, YW, YH, YTs) || YTs <= LastFrameTimestamp)
+	{
+		return false;
+	}
+
+	// comprobar dimensiones
+	if (Width != YW || Height != YH || YCurr.Num() != YW * YH)
+	{
+		Width = YW; Height = YH;
+		YCurr.SetNumZeroed(Width * Height);
+	}
+
+	LastFrameTimestamp = YTs;
+	return true;
+}
+
+FQuircLumaImage UQRCodeDetectionSubsystem::MakeImage(const FQRScanPlan& Plan)
+{
+	const FIntRect& R = Plan.Region;
+	const uint8* Src = YCurr.GetData() + R.Min.Y * Width + R.Min.X;
+
+	FQuircLumaImage Image;
+	Image.Origin = FVector2D(R.Min.X, R.Min.Y);
+
+	if (Plan.Downscale == 2)
+	{
+		// Media 2x2 de la región
+		const int32 W2 = R.Width() / 2;
+		const int32 H2 = R.Height() / 2;
+		YHalf.SetNumUninitialized(W2 * H2, EAllowShrinking::No);
+
+		for (int32 Y = 0; Y < H2; ++Y)
+		{
+			const uint8* Row0 = Src + (2 * Y) * Width;
+			const uint8* Row1 = Row0 + Width;
+			uint8* Dst = YHalf.GetData() + Y * W2;
+			for (int32 X = 0; X < W2; ++X)
+			{
+				Dst[X] = static_cast<uint8>((Row0[2 * X] + Row0[2 * X + 1] + Row1[2 * X] + Row1[2 * X + 1] + 2) >> 2);
+			}
+		}
+
+		Image.Luma = YHalf.GetData();
+		Image.Width = W2;
+		Image.Height = H2;
+		Image.Stride = W2;
+		Image.Scale = 2.0f;
+	}
+	else
+	{
+		Image.Luma = Src;
+		Image.Width = R.Width();
+		Image.Height = R.Height();
+		Image.Stride = Width;
+	}
+
+	return Image;
+}
+
+void UQRCodeDetectionSubsystem::Tick(float DeltaTime)
+{
+	Scheduler.AddGameFrame();
+
+	const uint8* YPtr = nullptr;
+	if (!FetchFrame(YPtr))
+	{
+		// no hay frame nuevo, salir
+		return;
+	}
+
+	// El prefiltro se usa sólo si todos los componentes lo aceptan, con el paso más fino
+	// pedido; el presupuesto es el menor positivo.
+	bool bUsePrefilter = true;
+	bool bSkipStaticFrames = true;
+	int32 PrefilterStep = MAX_int32;
+	float BudgetMs = 0.f;
+	for (int32 i = Listeners.Num() - 1; i >= 0; --i)
+	{
+		const UQRCodeDetectionComp* Listener = Listeners[i].Get();
+		if (!Listener)
+		{
+			Listeners.RemoveAtSwap(i);
+			continue;
+		}
+		bUsePrefilter &= Listener->bUsePrefilter;
+		bSkipStaticFrames &= Listener->bSkipStaticFrames;
+		PrefilterStep = FMath::Min(PrefilterStep, Listener->PrefilterStep);
+		if (Listener->ScanBudgetMs > 0.f)
+		{
+			BudgetMs = (BudgetMs > 0.f) ? FMath::Min(BudgetMs, Listener->ScanBudgetMs) : Listener->ScanBudgetMs;
+		}
+	}
+	if (PrefilterStep == MAX_int32)
+	{
+		PrefilterStep = 4;
+	}
+
+	// Nada ha cambiado desde el último frame escaneado: las detecciones siguen valiendo.
+	UAndroidCamera2Subsystem* Cam2 = GetGameInstance()->GetSubsystem<UAndroidCamera2Subsystem>();
+	if (bSkipStaticFrames && Cam2 && Cam2->IsSceneChangeDetectionEnabled() &&
+	    Cam2->GetLastSceneChangeTimestamp() <= LastScannedTimestamp)
+	{
+		INC_DWORD_STAT(STAT_QRStaticFramesSkipped);
+		return;
+	}
+
+	Scheduler.SetBudgetMs(BudgetMs);
+	const FQRScanPlan Plan = Scheduler.Plan(Width, Height, QRDetections);
+	if (!Plan.bScan)
+	{
+		// Frame omitido por presupuesto: se conservan las detecciones anteriores.
+		return;
+	}
+
+	const uint64 T0 = FPlatformTime::Cycles64();
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QRScan_GT);
+
+		// copiar luminancia
+		FMemory::Memcpy(YCurr.GetData(), YPtr, Width * Height);
+		LastScannedTimestamp = LastFrameTimestamp;
+		const FAndroidCamera2FrameTimes FrameTimes = Cam2 ? Cam2->GetLastFrameTimes() : FAndroidCamera2FrameTimes();
+
+		const FQuircLumaImage Image = MakeImage(Plan);
+		if (!bUsePrefilter || FQuircReader::HasFinderCandidates(Image.Luma, Image.Width, Image.Height, Image.Stride, PrefilterStep))
+		{
+			FQuircReader::DecodeFromLuma(Image, ResultArena);
+		}
+		else
+		{
+			// sin candidatos: nada que decodificar en este frame
+			ResultArena.MarkEmptyFrame();
+		}
+		ResultArena.CopyTo(QRDetections);
+
+		if (Cam2 && FrameTimes.Sequence != 0)
+		{
+			Cam2->ReportQRDecoded(FrameTimes, FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - T0));
+		}
+	}
+	const double ElapsedMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - T0);
+
+	Scheduler.Report(Plan, ElapsedMs, QRDetections.Num());
+	DecodeLatency.AddSample(ElapsedMs);
+#if STATS
+	const FAndroidCamera2LatencyStats Latency = DecodeLatency.GetStats();
+	SET_FLOAT_STAT(STAT_LatencyQR_P50, Latency.P50Ms);
+	SET_FLOAT_STAT(STAT_LatencyQR_P95, Latency.P95Ms);
+	SET_FLOAT_STAT(STAT_LatencyQR_P99, Latency.P99Ms);
+	SET_FLOAT_STAT(STAT_LatencyQR_Max, Latency.MaxMs);
+#endif
+	SET_FLOAT_STAT(STAT_QRScansPerSecond, Scheduler.GetScansPerSecond());
+	SET_DWORD_STAT(STAT_QRBudgetOverruns_1s, Scheduler.GetOverrunsPerSecond());
+	SET_FLOAT_STAT(STAT_QRScanCostPerMP, Scheduler.GetMsPerMegapixel());
+
+	// Un oyente puede darse de baja desde su delegate: iterar sobre una copia de punteros.
+	TArray<TWeakObjectPtr<UQRCodeDetectionComp>, TInlineAllocator<8>> Snapshot(Listeners);
+	for (const TWeakObjectPtr<UQRCodeDetectionComp>& Listener : Snapshot)
+	{
+		if (UQRCodeDetectionComp* Comp = Listener.Get())
+		{
+			if (Comp->OnQRCodeDetected.IsBound())
+			{
+				Comp->OnQRCodeDetected.Broadcast(QRDetections);
+			}
+		}
+	}
+
+	if (OnQRCodeDetected.IsBound())
+	{
+		OnQRCodeDetected.Broadcast(QRDetections);
+	}
+}
@@ -0,0 +1,386 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+
+#include "QRMarkerPose.h"
+
+namespace QRMarkerPose
+{
+	struct FVec3
+	{
+		double X = 0.0, Y = 0.0, Z = 0.0;
+
+		FVec3() {}
+		FVec3(double InX, double InY, double InZ) : X(InX), Y(InY), Z(InZ) {}
+
+		FVec3 operator+(const FVec3& O) const { return FVec3(X + O.X, Y + O.Y, Z + O.Z); }
+		FVec3 operator-(const FVec3& O) const { return FVec3(X - O.X, Y - O.Y, Z - O.Z); }
+		FVec3 operator*(double S) const { return FVec3(X * S, Y * S, Z * S); }
+		double Dot(const FVec3& O) const { return X * O.X + Y * O.Y + Z * O.Z; }
+		FVec3 Cross(const FVec3& O) const { return FVec3(Y * O.Z - Z * O.Y, Z * O.X - X * O.Z, X * O.Y - Y * O.X); }
+		double Length() const { return FMath::Sqrt(Dot(*this)); }
+		FVec3 Normal() const { const double L = Length(); return L > 0.0 ? *this * (1.0 / L) : *this; }
+	};
+
+	// Row-major rotation; columns are the marker axes in the camera's optical frame.
+	struct FRot3
+	{
+		double M[3][3];
+
+		FVec3 operator*(const FVec3& V) const
+		{
+			return FVec3(M[0][0] * V.X + M[0][1] * V.Y + M[0][2] * V.Z,
+			             M[1][0] * V.X + M[1][1] * V.Y + M[1][2] * V.Z,
+			             M[2][0] * V.X + M[2][1] * V.Y + M[2][2] * V.Z);
+		}
+	};
+
+	// Homography from the unit square to a quad (TL, TR, BR, BL), row major 3x3.
+	static bool SquareToQuad(const double (*Q)[2], double* H)
+	{
+		const double DX1 = Q[1][0] - Q[2][0], DX2 = Q[3][0] - Q[2][0], DX3 = Q[0][0] - Q[1][0] + Q[2][0] - Q[3][0];
+		const double DY1 = Q[1][1] - Q[2][1], DY2 = Q[3][1] - Q[2][1], DY3 = Q[0][1] - Q[1][1] + Q[2][1] - Q[3][1];
+
+		const double Det = DX1 * DY2 - DX2 * DY1;
+		if (FMath::Abs(Det) < 1e-18)
+		{
+			return false;
+		}
+
+		const double G = (DX3 * DY2 - DX2 * DY3) / Det;
+		const double Hh = (DX1 * DY3 - DX3 * DY1) / Det;
+
+		H[0] = Q[1][0] - Q[0][0] + G * Q[1][0];
+		H[1] = Q[3][0] - Q[0][0] + Hh * Q[3][0];
+		H[2] = Q[0][0];
+		H[3] = Q[1][1] - Q[0][1] + G * Q[1][1];
+		H[4] = Q[3][1] - Q[0][1] + Hh * Q[3][1];
+		H[5] = Q[0][1];
+		H[6] = G;
+		H[7] = Hh;
+		H[8] = 1.0;
+		return true;
+	}
+
+	// R <- exp([W]x) R (Rodrigues).
+	static void RotateLeft(FRot3& R, const FVec3& W)
+	{
+		const double Theta = W.Length();
+		if (Theta < 1e-15)
+		{
+			return;
+		}
+
+		const FVec3 K = W * (1.0 / Theta);
+		const double S = FMath::Sin(Theta);
+		const double C1 = 1.0 - FMath::Cos(Theta);
+		const double E[3][3] =
+		{
+			{ 1.0 - C1 * (K.Y * K.Y + K.Z * K.Z), -S * K.Z + C1 * K.X * K.Y,           S * K.Y + C1 * K.X * K.Z },
+			{ S * K.Z + C1 * K.X * K.Y,           1.0 - C1 * (K.X * K.X + K.Z * K.Z), -S * K.X + C1 * K.Y * K.Z },
+			{ -S * K.Y + C1 * K.X * K.Z,          S * K.X + C1 * K.Y * K.Z,           1.0 - C1 * (K.X * K.X + K.Y * K.Y) }
+		};
+
+		FRot3 Out;
+		for (int32 i = 0; i < 3; ++i)
+		{
+			for (int32 j = 0; j < 3; ++j)
+			{
+				Out.M[i][j] = E[i][0] * R.M[0][j] + E[i][1] * R.M[1][j] + E[i][2] * R.M[2][j];
+			}
+		}
+		R = Out;
+	}
+
+	// Solves A x = B for a 6x6 symmetric positive definite A (Cholesky, in place).
+	static bool SolveNormal6(double (&A)[6][6], double (&B)[6])
+	{
+		for (int32 j = 0; j < 6; ++j)
+		{
+			double D = A[j][j];
+			for (int32 k = 0; k < j; ++k)
+			{
+				D -= A[j][k] * A[j][k];
+			}
+			if (D <= 0.0)
+			{
+				return false;
+			}
+			A[j][j] = FMath::Sqrt(D);
+
+			for (int32 i = j + 1; i < 6; ++i)
+			{
+				double S = A[i][j];
+				for (int32 k = 0; k < j; ++k)
+				{
+					S -= A[i][k] * A[j][k];
+				}
+				A[i][j] = S / A[j][j];
+			}
+		}
+
+		for (int32 i = 0; i < 6; ++i)
+		{
+			for (int32 k = 0; k < i; ++k)
+			{
+				B[i] -= A[i][k] * B[k];
+			}
+			B[i] /= A[i][i];
+		}
+		for (int32 i = 5; i >= 0; --i)
+		{
+			for (int32 k = i + 1; k < 6; ++k)
+			{
+				B[i] -= A[k][i] * B[k];
+			}
+			B[i] /= A[i][i];
+		}
+		return true;
+	}
+
+	static constexpr int32 MaxIterations = 10;
+}
+
+FQRPoseSolver::FQRPoseSolver(const FAndroidCamera2Intrinsics& Intrinsics, const FAndroidCamera2LensPose& LensPose,
+                             FIntPoint ImageSize, EAndroidCamera2RotationMode Rotation, float MarkerSize)
+{
+	Fx = Intrinsics.FocalLength.X;
+	Fy = Intrinsics.FocalLength.Y;
+	Cx = Intrinsics.PrincipalPoint.X;
+	Cy = Intrinsics.PrincipalPoint.Y;
+	Skew = Intrinsics.Skew;
+	ImageW = ImageSize.X;
+	ImageH = ImageSize.Y;
+	HalfSize = 0.5 * MarkerSize;
+
+	// Mismo criterio que Camera2UE.initializeCamera para RSensor.
+	QuarterTurns = (Rotation == EAndroidCamera2RotationMode::RSensor)
+		? (Intrinsics.SensorOrientation / 90) & 3
+		: static_cast<int32>(Rotation) & 3;
+
+	bValid = Fx > 0.0 && Fy > 0.0 && ImageW > 0.0 && ImageH > 0.0 && HalfSize > 0.0;
+	if (!bValid)
+	{
+		return;
+	}
+
+	// El stream cubre la mayor región centrada del active array con su aspecto.
+	const double StreamW = (QuarterTurns & 1) ? ImageH : ImageW;
+	const double StreamH = (QuarterTurns & 1) ? ImageW : ImageH;
+	const double ActiveW = Intrinsics.ActiveSensorMax.X - Intrinsics.ActiveSensorMin.X;
+	const double ActiveH = Intrinsics.ActiveSensorMax.Y - Intrinsics.ActiveSensorMin.Y;
+
+	if (ActiveW > 0.0 && ActiveH > 0.0)
+	{
+		const double CropW = (StreamW * ActiveH >= StreamH * ActiveW) ? ActiveW : ActiveH * StreamW / StreamH;
+		const double CropH = CropW * StreamH / StreamW;
+		StreamToActive = CropW / StreamW;
+		CropX = Intrinsics.ActiveSensorMin.X + 0.5 * (ActiveW - CropW);
+		CropY = Intrinsics.ActiveSensorMin.Y + 0.5 * (ActiveH - CropH);
+	}
+
+	LensRotation = LensPose.OrientationUECoord;
+	LensLocation = LensPose.LocationUECoord * 100.0;
+}
+
+void FQRPoseSolver::ToNormalized(const FVector2D& Pixel, double& OutX, double& OutY) const
+{
+	// Deshace I420Rotate (libyuv gira en sentido horario).
+	double X, Y;
+	switch (QuarterTurns)
+	{
+	case 1:  X = Pixel.Y;          Y = ImageW - Pixel.X; break;
+	case 2:  X = ImageW - Pixel.X; Y = ImageH - Pixel.Y; break;
+	case 3:  X = ImageH - Pixel.Y; Y = Pixel.X;          break;
+	default: X = Pixel.X;          Y = Pixel.Y;          break;
+	}
+
+	X = X * StreamToActive + CropX;
+	Y = Y * StreamToActive + CropY;
+
+	OutY = (Y - Cy) / Fy;
+	OutX = (X - Cx - Skew * OutY) / Fx;
+}
+
+bool FQRPoseSolver::Solve(const FVector2D* Corners, FQRMarkerPose& Out) const
+{
+	using namespace QRMarkerPose;
+
+	Out.bValid = false;
+	if (!bValid || !Corners)
+	{
+		return false;
+	}
+
+	double Obs[4][2];
+	for (int32 i = 0; i < 4; ++i)
+	{
+		ToNormalized(Corners[i], Obs[i][0], Obs[i][1]);
+	}
+
+	// Marco del código en el sistema óptico (x derecha, y abajo, z hacia la escena):
+	// esquinas TL, TR, BR, BL en el plano z = 0.
+	const FVec3 Model[4] =
+	{
+		FVec3(-HalfSize, -HalfSize, 0.0), FVec3(HalfSize, -HalfSize, 0.0),
+		FVec3(HalfSize, HalfSize, 0.0), FVec3(-HalfSize, HalfSize, 0.0)
+	};
+
+	// Pose inicial: H ~ [r1 r2 t] con el cuadrado unidad -> (X, Y) = (u - 1/2, v - 1/2) * Size.
+	double H[9];
+	if (!SquareToQuad(Obs, H))
+	{
+		return false;
+	}
+
+	const double Size = 2.0 * HalfSize;
+	const FVec3 H1(H[0], H[3], H[6]);
+	const FVec3 H2(H[1], H[4], H[7]);
+	const FVec3 H3(H[2], H[5], H[8]);
+
+	double Lambda = 2.0 * Size / (H1.Length() + H2.Length());
+	FVec3 T = (H3 + (H1 + H2) * 0.5) * Lambda;
+	if (T.Z < 0.0)
+	{
+		Lambda = -Lambda;
+		T = T * -1.0;
+	}
+
+	// Ortonormaliza simétricamente r1, r2 alrededor de su bisectriz.
+	const FVec3 R1 = H1 * (Lambda / Size);
+	const FVec3 R2 = H2 * (Lambda / Size);
+	const FVec3 R3 = R1.Cross(R2).Normal();
+	const FVec3 A = (R1 + R2).Normal();
+	const FVec3 B = R3.Cross(A).Normal();
+	const double InvSqrt2 = 0.70710678118654752;
+	const FVec3 C1 = (A - B) * InvSqrt2;
+	const FVec3 C2 = (A + B) * InvSqrt2;
+
+	FRot3 R;
+	R.M[0][0] = C1.X; R.M[0][1] = C2.X; R.M[0][2] = R3.X;
+	R.M[1][0] = C1.Y; R.M[1][1] = C2.Y; R.M[1][2] = R3.Y;
+	R.M[2][0] = C1.Z; R.M[2][1] = C2.Z; R.M[2][2] = R3.Z;
+
+	// Gauss-Newton sobre (rotación incremental a la izquierda, traslación).
+	double SquaredError = 0.0;
+	for (int32 Iter = 0; Iter <= MaxIterations; ++Iter)
+	{
+		double JtJ[6][6] = {};
+		double Jtr[6] = {};
+		SquaredError = 0.0;
+
+		for (int32 i = 0; i < 4; ++i)
+		{
+			const FVec3 Q = R * Model[i];
+			const FVec3 P = Q + T;
+			if (P.Z <= 1e-9)
+			{
+				return false;
+			}
+
+			const double IZ = 1.0 / P.Z;
+			const double Res[2] = { P.X * IZ - Obs[i][0], P.Y * IZ - Obs[i][1] };
+			SquaredError += Res[0] * Res[0] + Res[1] * Res[1];
+
+			// d(proj)/dP y dP/dw = -[Q]x
+			const double DP[2][3] = { { IZ, 0.0, -P.X * IZ * IZ }, { 0.0, IZ, -P.Y * IZ * IZ } };
+			const double DW[3][3] = { { 0.0, Q.Z, -Q.Y }, { -Q.Z, 0.0, Q.X }, { Q.Y, -Q.X, 0.0 } };
+
+			for (int32 r = 0; r < 2; ++r)
+			{
+				double J[6];
+				for (int32 k = 0; k < 3; ++k)
+				{
+					J[k] = DP[r][0] * DW[0][k] + DP[r][1] * DW[1][k] + DP[r][2] * DW[2][k];
+					J[3 + k] = DP[r][k];
+				}
+				for (int32 a = 0; a < 6; ++a)
+				{
+					Jtr[a] += J[a] * Res[r];
+					for (int32 b = 0; b <= a; ++b)
+					{
+						JtJ[a][b] += J[a] * J[b];
+					}
+				}
+			}
+		}
+
+		if (Iter == MaxIterations)
+		{
+			break;
+		}
+
+		double Trace = 0.0;
+		for (int32 a = 0; a < 6; ++a)
+		{
+			Trace += JtJ[a][a];
+			Jtr[a] = -Jtr[a];
+		}
+		for (int32 a = 0; a < 6; ++a)
+		{
+			JtJ[a][a] += 1e-12 * Trace;
+		}
+
+		if (!SolveNormal6(JtJ, Jtr))
+		{
+			break;
+		}
+
+		RotateLeft(R, FVec3(Jtr[0], Jtr[1], Jtr[2]));
+		T = T + FVec3(Jtr[3], Jtr[4], Jtr[5]);
+
+		const double Step = FVec3(Jtr[0], Jtr[1], Jtr[2]).Length() + FVec3(Jtr[3], Jtr[4], Jtr[5]).Length() / T.Z;
+		if (Step < 1e-10)
+		{
+			break;
+		}
+	}
+
+	if (T.Z <= 0.0)
+	{
+		return false;
+	}
+
+	// Óptico (x der., y abajo, z adelante) -> UE (X adelante, Y der., Z arriba): (z, x, -y),
+	// igual que MapToUE en el subsistema. Ejes del código: normal -> X, derecha -> Y, arriba -> Z.
+	auto ToUE = [](const FVec3& V) { return FVector(V.Z, V.X, -V.Y); };
+	const FVector AxisX = ToUE(FVec3(R.M[0][2], R.M[1][2], R.M[2][2]));
+	const FVector AxisY = ToUE(FVec3(R.M[0][0], R.M[1][0], R.M[2][0]));
+	const FVector AxisZ = ToUE(FVec3(R.M[0][1], R.M[1][1], R.M[2][1])) * -1.0;
+
+	const FQuat Local = FQuat(FMatrix(AxisX, AxisY, AxisZ, FVector::ZeroVector)).GetNormalized();
+
+	Out.Rotation = LensRotation * Local;
+	Out.Location = LensRotation.RotateVector(ToUE(T)) + LensLocation;
+	Out.ReprojectionError = static_cast<float>(FMath::Sqrt(SquaredError / 4.0) * Fx / StreamToActive);
+	Out.bValid = true;
+	return true;
+}
+
+int32 FQRPoseSolver::SolveAll(const TArray<FQRDetection>& Detections, TArray<FQRMarkerPose>& Out) const
+{
+	Out.SetNum(Detections.Num());
+
+	int32 NumValid = 0;
+	for (int32 i = 0; i < Detections.Num(); ++i)
+	{
+		const FQRDetection& Detection = Detections[i];
+		FQRMarkerPose& Pose = Out[i];
+		Pose.Id = Detection.Id;
+		Pose.DetectionIndex = i;
+
+		if (Detection.Corners.Num() == 4 && Solve(Detection.Corners.GetData(), Pose))
+		{
+			++NumValid;
+		}
+	}
+	return NumValid;
+}
+
+int32 UQRMarkerPoseLibrary::SolveQRMarkerPoses(const TArray<FQRDetection>& Detections, const FAndroidCamera2Intrinsics& Intrinsics,
+                                               const FAndroidCamera2LensPose& LensPose, FIntPoint ImageSize,
+                                               EAndroidCamera2RotationMode Rotation, float MarkerSize, TArray<FQRMarkerPose>& OutPoses)
+{
+	const FQRPoseSolver Solver(Intrinsics, LensPose, ImageSize, Rotation, MarkerSize);
+	return Solver.SolveAll(Detections, OutPoses);
+}
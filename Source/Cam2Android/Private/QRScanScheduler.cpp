@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+
+#include "QRScanScheduler.h"
+
+namespace QRScanScheduler
+{
+	// Escaneo completo al menos cada tantos escaneos de ROI, para ver códigos nuevos.
+	static constexpr int32 FullScanInterval = 8;
+
+	// Margen alrededor de los códigos, en lados de código: cubre el movimiento entre escaneos.
+	static constexpr double RegionMargin = 0.75;
+
+	// Por encima de esta fracción del frame el ROI no compensa.
+	static constexpr double MaxRegionFraction = 0.6;
+
+	// Las dimensiones del ROI se alinean a 64 px para que el contexto quirc no se
+	// redimensione con cada pequeño cambio de región.
+	static constexpr int32 RegionAlign = 64;
+
+	// Lado mínimo (px) que debe conservar un código tras reducir a la mitad.
+	static constexpr double MinSideAfterDownscale = 120.0;
+
+	// Presupuesto acumulable: frames de juego sin escanear que se pueden "ahorrar".
+	static constexpr double MaxCreditFrames = 4.0;
+
+	static constexpr double CostSmoothing = 0.2;
+}
+
+FQRScanScheduler::FQRScanScheduler()
+{
+	for (int32 i = 0; i < NumBuckets; ++i)
+	{
+		BucketIds[i] = 0;
+		Scans[i] = 0;
+		Overruns[i] = 0;
+	}
+}
+
+uint64 FQRScanScheduler::NowBucket()
+{
+	return static_cast<uint64>(FPlatformTime::Seconds() * NumBuckets);
+}
+
+int32 FQRScanScheduler::SumWindow(const int32* Counts) const
+{
+	const uint64 Now = NowBucket();
+	int32 Sum = 0;
+	for (int32 i = 0; i < NumBuckets; ++i)
+	{
+		if (Now - BucketIds[i] < NumBuckets)
+		{
+			Sum += Counts[i];
+		}
+	}
+	return Sum;
+}
+
+float FQRScanScheduler::GetScansPerSecond() const
+{
+	return static_cast<float>(SumWindow(Scans));
+}
+
+int32 FQRScanScheduler::GetOverrunsPerSecond() const
+{
+	return SumWindow(Overruns);
+}
+
+void FQRScanScheduler::AddGameFrame()
+{
+	if (BudgetMs <= 0.f)
+	{
+		Credit = 0.0;
+		return;
+	}
+
+	// Tope: unos cuantos frames, o lo que cueste el escaneo previsto si es mayor,
+	// para que un escaneo caro acabe ejecutándose a menor frecuencia.
+	const double Cap = FMath::Max(BudgetMs * QRScanScheduler::MaxCreditFrames, LastPredictedMs);
+	Credit = FMath::Min(Credit + BudgetMs, Cap);
+}
+
+FIntRect FQRScanScheduler::RegionAround(const TArray<FQRDetection>& Previous, int32 Width, int32 Height, double& OutMinSide)
+{
+	using namespace QRScanScheduler;
+
+	double MinX = TNumericLimits<double>::Max(), MinY = TNumericLimits<double>::Max();
+	double MaxX = -MinX, MaxY = -MinY;
+	double MaxSide = 0.0;
+	OutMinSide = TNumericLimits<double>::Max();
+
+	for (const FQRDetection& Detection : Previous)
+	{
+		if (Detection.Corners.Num() != 4)
+		{
+			continue;
+		}
+
+		const double Side = FMath::Max(FVector2D::Distance(Detection.Corners[0], Detection.Corners[2]),
+		                               FVector2D::Distance(Detection.Corners[1], Detection.Corners[3])) * UE_INV_SQRT_2;
+		MaxSide = FMath::Max(MaxSide, Side);
+		OutMinSide = FMath::Min(OutMinSide, Side);
+
+		for (const FVector2D& C : Detection.Corners)
+		{
+			MinX = FMath::Min(MinX, C.X); MaxX = FMath::Max(MaxX, C.X);
+			MinY = FMath::Min(MinY, C.Y); MaxY = FMath::Max(MaxY, C.Y);
+		}
+	}
+
+	if (MaxSide <= 0.0)
+	{
+		return FIntRect(0, 0, Width, Height);
+	}
+
+	const double Margin = MaxSide * RegionMargin;
+	const int32 X0 = FMath::Clamp(FMath::FloorToInt32(MinX - Margin), 0, Width);
+	const int32 Y0 = FMath::Clamp(FMath::FloorToInt32(MinY - Margin), 0, Height);
+	const int32 X1 = FMath::Clamp(FMath::CeilToInt32(MaxX + Margin), 0, Width);
+	const int32 Y1 = FMath::Clamp(FMath::CeilToInt32(MaxY + Margin), 0, Height);
+
+	// Alinea el tamaño hacia arriba, desplazando la región si choca con el borde.
+	const int32 W = FMath::Min(Width, Align(X1 - X0, RegionAlign));
+	const int32 H = FMath::Min(Height, Align(Y1 - Y0, RegionAlign));
+	const int32 X = FMath::Min(X0, Width - W);
+	const int32 Y = FMath::Min(Y0, Height - H);
+
+	return FIntRect(X, Y, X + W, Y + H);
+}
+
+double FQRScanScheduler::Predict(const FIntRect& Region, int32 Downscale) const
+{
+	const double Pixels = static_cast<double>(Region.Area()) / (Downscale * Downscale);
+	return MsPerMegapixel * Pixels * 1e-6;
+}
+
+FQRScanPlan FQRScanScheduler::Plan(int32 Width, int32 Height, const TArray<FQRDetection>& Previous)
+{
+	using namespace QRScanScheduler;
+
+	FQRScanPlan Out;
+	Out.Region = FIntRect(0, 0, Width, Height);
+	Out.CreditMs = Credit;
+
+	if (BudgetMs <= 0.f || MsPerMegapixel <= 0.0)
+	{
+		// Sin presupuesto o sin medida todavía: frame completo.
+		Out.bScan = true;
+		Out.PredictedMs = Predict(Out.Region, 1);
+		return Out;
+	}
+
+	// Los códigos ya vistos limitan la reducción también en el escaneo completo periódico.
+	double MinSide = TNumericLimits<double>::Max();
+	if (Previous.Num() > 0)
+	{
+		const FIntRect Region = RegionAround(Previous, Width, Height, MinSide);
+		if (bLastRegionFound && ScansSinceFull < FullScanInterval && Region.Area() < MaxRegionFraction * Width * Height)
+		{
+			Out.Region = Region;
+			Out.bFullFrame = false;
+		}
+	}
+
+	Out.PredictedMs = Predict(Out.Region, 1);
+	if (Out.PredictedMs > BudgetMs && MinSide * 0.5 >= MinSideAfterDownscale &&
+	    Out.Region.Width() >= 2 * RegionAlign && Out.Region.Height() >= 2 * RegionAlign)
+	{
+		Out.Downscale = 2;
+		Out.PredictedMs = Predict(Out.Region, 2);
+	}
+
+	LastPredictedMs = Out.PredictedMs;
+	Out.bScan = Credit >= Out.PredictedMs;
+	return Out;
+}
+
+void FQRScanScheduler::Report(const FQRScanPlan& InPlan, double ElapsedMs, int32 NumFound)
+{
+	using namespace QRScanScheduler;
+
+	const double Megapixels = static_cast<double>(InPlan.Region.Area()) / (InPlan.Downscale * InPlan.Downscale) * 1e-6;
+	if (Megapixels > 0.0)
+	{
+		const double Sample = ElapsedMs / Megapixels;
+		MsPerMegapixel = (MsPerMegapixel <= 0.0) ? Sample : FMath::Lerp(MsPerMegapixel, Sample, CostSmoothing);
+	}
+
+	Credit = FMath::Max(0.0, Credit - ElapsedMs);
+
+	ScansSinceFull = InPlan.bFullFrame ? 0 : ScansSinceFull + 1;
+	bLastRegionFound = NumFound > 0;
+
+	const uint64 Bucket = NowBucket();
+	const int32 Index = static_cast<int32>(Bucket % NumBuckets);
+	if (BucketIds[Index] != Bucket)
+	{
+		BucketIds[Index] = Bucket;
+		Scans[Index] = 0;
+		Overruns[Index] = 0;
+	}
+
+	++Scans[Index];
+	// Gastar el presupuesto acumulado no es un exceso; sólo lo es pasarse de lo disponible.
+	if (BudgetMs > 0.f && ElapsedMs > FMath::Max<double>(BudgetMs, InPlan.CreditMs))
+	{
+		++Overruns[Index];
+	}
+}
@@ -6,10 +6,13 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "QuircReader.h"
+#include "QRCodeDetectionSubsystem.h"
 #include "QRCodeDetectionComp.generated.h"
 
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnQRCodeDetected, TArray<FQRDetection>, QRCodesDetected);
-
+/**
+ * Oyente de UQRCodeDetectionSubsystem: el frame se decodifica una vez en el
+ * servicio y todos los componentes reciben el mismo resultado.
+ */
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class CAM2ANDROID_API UQRCodeDetectionComp : public UActorComponent
 {
@@ -20,30 +23,48 @@ public:
 	UQRCodeDetectionComp();
 
 	UFUNCTION(BlueprintPure, Category = "Quirc QRCode")
-	TArray<FQRDetection>  GetQRCodesDetected() const { return QRDetections; }
+	const TArray<FQRDetection>& GetQRCodesDetected() const;
 
 	UPROPERTY(BlueprintAssignable, Category = "Quirc QRCode")
 	FOnQRCodeDetected OnQRCodeDetected;
 
+	/**
+	 * Descarta frames sin finder patterns antes de la decodificación completa.
+	 * Usa un único umbral para todo el frame, así que con iluminación desigual
+	 * (degradados, sombras) puede descartar frames que quirc sí decodifica; por eso
+	 * está desactivado por defecto.
+	 * El servicio sólo usa el prefiltro si todos los componentes lo tienen activo.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Quirc QRCode")
+	bool bUsePrefilter = false;
+
+	/** Separación entre filas muestreadas por el prefiltro (px); el servicio usa la menor. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Quirc QRCode", meta = (ClampMin = "1", ClampMax = "16", EditCondition = "bUsePrefilter"))
+	int32 PrefilterStep = 4;
+
+	/**
+	 * Presupuesto de escaneo por frame de juego (ms); 0 = escanear cada frame completo.
+	 * El servicio usa el menor presupuesto positivo de sus componentes.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Quirc QRCode", meta = (ClampMin = "0", UIMin = "0", UIMax = "16"))
+	float ScanBudgetMs = 0.f;
+
+	/**
+	 * No vuelve a decodificar frames que el detector de cambio de escena del subsistema
+	 * de cámara marca como estáticos (requiere Scene Change activo en Project Settings).
+	 * El servicio sólo los salta si todos los componentes lo permiten.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Quirc QRCode")
+	bool bSkipStaticFrames = true;
+
 
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
-public:	
-	// Called every frame
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
-	void InitializeLuma(int32 InWidth, int32 InHeight);
-	// Dimensiones (compactas)
-	int32 Width = 0;
-	int32 Height = 0;
-
-	// Buffer CPU compactos W*H
-	uint64 LastFrameTimestamp = 0;
-	TArray<uint8> YCurr;
-
-	TArray<FQRDetection> QRDetections;
+	TWeakObjectPtr<UQRCodeDetectionSubsystem> Service;
 
 };
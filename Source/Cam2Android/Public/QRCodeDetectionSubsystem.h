@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "QuircReader.h"
+#include "QRScanScheduler.h"
+#include "AndroidCamera2LatencyHistogram.h"
+#include "QRCodeDetectionSubsystem.generated.h"
+
+class UQRCodeDetectionComp;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnQRCodeDetected, TArray<FQRDetection>, QRCodesDetected);
+
+/**
+ * Servicio de detección compartido: decodifica cada frame de cámara una sola vez
+ * y reparte el resultado a todos los UQRCodeDetectionComp registrados y a
+ * OnQRCodeDetected. El coste por frame no depende del número de oyentes; sólo
+ * hace tick mientras haya alguno. Con ScanBudgetMs en algún componente, el
+ * escaneo se ajusta a ese presupuesto (ver FQRScanScheduler).
+ */
+UCLASS()
+class CAM2ANDROID_API UQRCodeDetectionSubsystem final : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	// Subsystem
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	/** Se llama una vez por frame de cámara decodificado. */
+	UPROPERTY(BlueprintAssignable, Category = "Quirc QRCode")
+	FOnQRCodeDetected OnQRCodeDetected;
+
+	/** Detecciones del último frame decodificado (compartidas por todos los oyentes). */
+	UFUNCTION(BlueprintPure, Category = "Quirc QRCode")
+	const TArray<FQRDetection>& GetQRCodesDetected() const { return QRDetections; }
+
+	/** Timestamp del frame al que corresponden las detecciones. */
+	uint64 GetFrameTimestamp() const { return LastFrameTimestamp; }
+
+	/** Tamaño de la imagen de luminancia decodificada. */
+	FIntPoint GetFrameSize() const { return FIntPoint(Width, Height); }
+
+	/** Escaneos realizados en el último segundo. */
+	UFUNCTION(BlueprintPure, Category = "Quirc QRCode")
+	float GetScansPerSecond() const { return Scheduler.GetScansPerSecond(); }
+
+	/** Escaneos que superaron el presupuesto en el último segundo. */
+	UFUNCTION(BlueprintPure, Category = "Quirc QRCode")
+	int32 GetBudgetOverruns() const { return Scheduler.GetOverrunsPerSecond(); }
+
+	/** p50/p95/p99/max del escaneo en los últimos WindowSeconds (<= 0: ventana completa de 1 s). */
+	UFUNCTION(BlueprintPure, Category = "Quirc QRCode")
+	FAndroidCamera2LatencyStats GetDecodeLatencyStats(float WindowSeconds = 0.f) const { return DecodeLatency.GetStats(WindowSeconds); }
+
+	void RegisterListener(UQRCodeDetectionComp* Listener);
+	void UnregisterListener(UQRCodeDetectionComp* Listener);
+
+private:
+	bool FetchFrame(const uint8*& OutLuma);
+	FQuircLumaImage MakeImage(const FQRScanPlan& Plan);
+
+	TArray<TWeakObjectPtr<UQRCodeDetectionComp>> Listeners;
+
+	// Dimensiones (compactas)
+	int32 Width = 0;
+	int32 Height = 0;
+
+	// Buffer CPU compacto W*H, copiado una vez por frame escaneado
+	uint64 LastFrameTimestamp = 0;
+	uint64 LastScannedTimestamp = 0;
+	TArray<uint8> YCurr;
+
+	// Región reducida a la mitad cuando el plan lo pide
+	TArray<uint8> YHalf;
+
+	FQRScanScheduler Scheduler;
+	FAndroidCamera2LatencyHistogram DecodeLatency;
+
+	FQuircResultArena ResultArena;
+	TArray<FQRDetection> QRDetections;
+};
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AndroidCamera2Subsystem.h"
+#include "QuircReader.h"
+#include "QRMarkerPose.generated.h"
+
+USTRUCT(BlueprintType)
+struct FQRMarkerPose
+{
+	GENERATED_BODY()
+
+	/** Id de la detección (FQRDetection::Id). */
+	UPROPERTY(BlueprintReadOnly, Category = "Quirc QRCode")
+	int32 Id = INDEX_NONE;
+
+	/** Posición en el array de detecciones de entrada. */
+	UPROPERTY(BlueprintReadOnly, Category = "Quirc QRCode")
+	int32 DetectionIndex = INDEX_NONE;
+
+	/** Centro del código en coordenadas UE (mismas unidades que MarkerSize). */
+	UPROPERTY(BlueprintReadOnly, Category = "Quirc QRCode")
+	FVector Location = FVector::ZeroVector;
+
+	/**
+	 * X: normal del código, alejándose de la cámara; Y: borde superior hacia la derecha;
+	 * Z: hacia arriba del código. Un código visto de frente y derecho tiene la rotación de la cámara.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Quirc QRCode")
+	FQuat Rotation = FQuat::Identity;
+
+	/** Error de reproyección RMS de las cuatro esquinas (px de la imagen). */
+	UPROPERTY(BlueprintReadOnly, Category = "Quirc QRCode")
+	float ReprojectionError = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Quirc QRCode")
+	bool bValid = false;
+};
+
+/**
+ * PnP planar para los cuatro vértices de un QR: homografía -> pose inicial,
+ * refinada con Gauss-Newton sobre el error de reproyección. Se construye una vez
+ * por cámara/resolución y resuelve cada código en microsegundos.
+ *
+ * Las esquinas se esperan en píxeles de la imagen de luminancia entregada por el
+ * subsistema (ya rotada según EAndroidCamera2RotationMode); las intrínsecas vienen
+ * en píxeles del active array, así que se deshace la rotación, el recorte centrado
+ * y el escalado del stream antes de aplicar K. No hay coeficientes de distorsión.
+ */
+class CAM2ANDROID_API FQRPoseSolver
+{
+public:
+	/**
+	 * @param Intrinsics  Intrínsecas de la cámara (GetCameraIntrinsics)
+	 * @param LensPose    Pose de la lente; la pose del código se compone con
+	 *                    OrientationUECoord / LocationUECoord (metros -> cm)
+	 * @param ImageSize   Tamaño de la imagen de luminancia (tras rotar)
+	 * @param Rotation    Rotación con la que se inicializó la cámara
+	 * @param MarkerSize  Lado del QR sin zona de silencio (cm)
+	 */
+	FQRPoseSolver(const FAndroidCamera2Intrinsics& Intrinsics, const FAndroidCamera2LensPose& LensPose,
+	              FIntPoint ImageSize, EAndroidCamera2RotationMode Rotation, float MarkerSize);
+
+	/** false si faltan intrínsecas o tamaños. */
+	bool IsValid() const { return bValid; }
+
+	/** Resuelve un código a partir de sus esquinas (TL, TR, BR, BL). */
+	bool Solve(const FVector2D* Corners, FQRMarkerPose& Out) const;
+
+	/**
+	 * Resuelve todas las detecciones; Out tiene una entrada por detección, en el mismo orden.
+	 * @return Número de poses válidas.
+	 */
+	int32 SolveAll(const TArray<FQRDetection>& Detections, TArray<FQRMarkerPose>& Out) const;
+
+private:
+	void ToNormalized(const FVector2D& Pixel, double& OutX, double& OutY) const;
+
+	double Fx = 0.0, Fy = 0.0, Cx = 0.0, Cy = 0.0, Skew = 0.0;
+	double StreamToActive = 1.0;
+	double CropX = 0.0, CropY = 0.0;
+	double ImageW = 0.0, ImageH = 0.0;
+	int32 QuarterTurns = 0;
+	double HalfSize = 0.0;
+	FQuat LensRotation = FQuat::Identity;
+	FVector LensLocation = FVector::ZeroVector;
+	bool bValid = false;
+};
+
+UCLASS()
+class CAM2ANDROID_API UQRMarkerPoseLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Pose 6-DoF de cada QR detectado, en coordenadas UE.
+	 * @return Número de poses válidas (OutPoses tiene una entrada por detección).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Quirc QRCode")
+	static int32 SolveQRMarkerPoses(const TArray<FQRDetection>& Detections, const FAndroidCamera2Intrinsics& Intrinsics,
+	                                const FAndroidCamera2LensPose& LensPose, FIntPoint ImageSize,
+	                                EAndroidCamera2RotationMode Rotation, float MarkerSize, TArray<FQRMarkerPose>& OutPoses);
+};
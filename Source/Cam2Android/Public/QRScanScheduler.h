@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "QuircReader.h"
+
+/** Qué escanear del frame actual. */
+struct FQRScanPlan
+{
+	bool bScan = false;
+	/** Región en píxeles de la imagen completa. */
+	FIntRect Region;
+	bool bFullFrame = true;
+	/** 1: resolución completa; 2: región reducida a la mitad. */
+	int32 Downscale = 1;
+	double PredictedMs = 0.0;
+	/** Presupuesto acumulado disponible al planificar. */
+	double CreditMs = 0.0;
+};
+
+/**
+ * Ajusta el escaneo de QR a un presupuesto de milisegundos por frame de juego.
+ * Mide el coste por megapíxel de cada escaneo y, con esa estimación:
+ * - escanea sólo la zona de los códigos ya detectados (con margen), con un
+ *   escaneo completo periódico o en cuanto el ROI pierde los códigos;
+ * - reduce la imagen a la mitad si la región no cabe en el presupuesto;
+ * - acumula presupuesto por frame de juego y sólo escanea cuando alcanza para el
+ *   coste previsto, así que la frecuencia baja cuando la decodificación se encarece.
+ * Con presupuesto 0 escanea cada frame completo, como antes.
+ */
+class CAM2ANDROID_API FQRScanScheduler
+{
+public:
+	FQRScanScheduler();
+
+	void SetBudgetMs(float InBudgetMs) { BudgetMs = FMath::Max(0.f, InBudgetMs); }
+	float GetBudgetMs() const { return BudgetMs; }
+
+	/** Una vez por frame de juego, haya o no frame de cámara nuevo. */
+	void AddGameFrame();
+
+	/** Decide qué hacer con un frame de cámara nuevo de Width x Height. */
+	FQRScanPlan Plan(int32 Width, int32 Height, const TArray<FQRDetection>& Previous);
+
+	/** Resultado de ejecutar un plan con bScan = true. */
+	void Report(const FQRScanPlan& InPlan, double ElapsedMs, int32 NumFound);
+
+	/** Escaneos en el último segundo. */
+	float GetScansPerSecond() const;
+
+	/** Escaneos que superaron el presupuesto del frame y el acumulado al planificar, en el último segundo. */
+	int32 GetOverrunsPerSecond() const;
+
+	/** Coste medido (ms por megapíxel escaneado). */
+	double GetMsPerMegapixel() const { return MsPerMegapixel; }
+
+private:
+	static FIntRect RegionAround(const TArray<FQRDetection>& Previous, int32 Width, int32 Height, double& OutMinSide);
+	double Predict(const FIntRect& Region, int32 Downscale) const;
+	static uint64 NowBucket();
+	int32 SumWindow(const int32* Counts) const;
+
+	float BudgetMs = 0.f;
+	double Credit = 0.0;
+	double LastPredictedMs = 0.0;
+	double MsPerMegapixel = 0.0;
+
+	int32 ScansSinceFull = 0;
+	bool bLastRegionFound = false;
+
+	// Ventana de 1 s en 10 cubetas de 100 ms (como FRollingSpikeCounter).
+	static constexpr int32 NumBuckets = 10;
+	uint64 BucketIds[NumBuckets];
+	int32 Scans[NumBuckets];
+	int32 Overruns[NumBuckets];
+};
@@ -11,5 +11,6 @@ public class Cam2AndroidEditorTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_6;
 		ExtraModuleNames.Add("Cam2Android");
+		ExtraModuleNames.Add("QuircBenchmark");
 	}
 }
@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+#include "QuircReader.h"
+
+#if PLATFORM_CPU_ARM_FAMILY && PLATFORM_64BITS
+	#include <arm_neon.h>
+	#define QUIRC_PREFILTER_NEON 1
+#elif PLATFORM_CPU_X86_FAMILY
+	#include <emmintrin.h>
+	#define QUIRC_PREFILTER_SSE2 1
+#endif
+
+// "Is there a QR code here?" test run before the full quirc pipeline. It only looks
+// at every Step-th row, packs it to one bit per pixel and walks the runs the same
+// way quirc's finder scan does, so a frame without codes costs a small fraction
+// of binarize + label + capstone + grid.
+namespace QuircPrefilter
+{
+	// Otsu threshold over a Step x Step subsample of the frame.
+	static uint8 SubsampledOtsu(const uint8* Luma, int32 W, int32 H, int32 Stride, int32 Step)
+	{
+		uint32 Histogram[256] = {};
+		uint32 NumPixels = 0;
+
+		for (int32 Y = 0; Y < H; Y += Step)
+		{
+			const uint8* Row = Luma + Y * Stride;
+			for (int32 X = 0; X < W; X += Step)
+			{
+				++Histogram[Row[X]];
+				++NumPixels;
+			}
+		}
+
+		double Sum = 0.0;
+		for (int32 i = 0; i < 256; ++i)
+		{
+			Sum += static_cast<double>(i) * Histogram[i];
+		}
+
+		double SumB = 0.0;
+		uint32 WeightB = 0;
+		double MaxVariance = 0.0;
+		uint8 Threshold = 0;
+
+		for (int32 i = 0; i < 256; ++i)
+		{
+			WeightB += Histogram[i];
+			if (WeightB == 0)
+			{
+				continue;
+			}
+
+			const uint32 WeightF = NumPixels - WeightB;
+			if (WeightF == 0)
+			{
+				break;
+			}
+
+			SumB += static_cast<double>(i) * Histogram[i];
+			const double MeanB = SumB / WeightB;
+			const double MeanF = (Sum - SumB) / WeightF;
+			const double Variance = static_cast<double>(WeightB) * WeightF * (MeanB - MeanF) * (MeanB - MeanF);
+
+			if (Variance >= MaxVariance)
+			{
+				Threshold = static_cast<uint8>(i);
+				MaxVariance = Variance;
+			}
+		}
+
+		return Threshold;
+	}
+
+	// Packs Row[X] < Threshold (dark, as quirc's binarizer) into 64-pixel words, LSB first.
+	static void PackRow(const uint8* Row, int32 W, uint8 Threshold, uint64* OutBits)
+	{
+		int32 X = 0;
+
+#if QUIRC_PREFILTER_NEON
+		static const uint8 BitWeights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+		const uint8x16_t Weights = vld1q_u8(BitWeights);
+		const uint8x16_t T = vdupq_n_u8(Threshold);
+
+		for (; X + 16 <= W; X += 16)
+		{
+			const uint8x16_t Dark = vandq_u8(vcltq_u8(vld1q_u8(Row + X), T), Weights);
+			const uint64 Mask = static_cast<uint64>(vaddv_u8(vget_low_u8(Dark))) |
+			                    (static_cast<uint64>(vaddv_u8(vget_high_u8(Dark))) << 8);
+			uint64& Word = OutBits[X >> 6];
+			Word = ((X & 63) ? Word : 0) | (Mask << (X & 63));
+		}
+#elif QUIRC_PREFILTER_SSE2
+		const __m128i T = _mm_set1_epi8(static_cast<char>(Threshold));
+
+		for (; X + 16 <= W; X += 16)
+		{
+			// p < t  <=>  max(p, t) != p
+			const __m128i P = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Row + X));
+			const uint64 Mask = ~static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(P, T), P))) & 0xffffu;
+			uint64& Word = OutBits[X >> 6];
+			Word = ((X & 63) ? Word : 0) | (Mask << (X & 63));
+		}
+#endif
+
+		for (; X < W; ++X)
+		{
+			uint64& Word = OutBits[X >> 6];
+			if ((X & 63) == 0)
+			{
+				Word = 0;
+			}
+			Word |= static_cast<uint64>(Row[X] < Threshold) << (X & 63);
+		}
+	}
+
+	// First X' >= X whose colour differs from bDark, or W.
+	static int32 NextTransition(const uint64* Bits, int32 NumWords, int32 W, int32 X, bool bDark)
+	{
+		const uint64 Flip = bDark ? ~0ull : 0ull;
+		int32 i = X >> 6;
+		uint64 Word = (Bits[i] ^ Flip) & (~0ull << (X & 63));
+
+		while (!Word)
+		{
+			if (++i >= NumWords)
+			{
+				return W;
+			}
+			Word = Bits[i] ^ Flip;
+		}
+
+		return FMath::Min(W, (i << 6) + static_cast<int32>(FMath::CountTrailingZeros64(Word)));
+	}
+
+	// quirc's finder tolerance: every run within 3/4 of its expected width.
+	static bool IsFinderRatio(const int32* Runs)
+	{
+		static const int32 Check[5] = { 1, 1, 3, 1, 1 };
+		const int32 Scale = 16;
+		const int32 Avg = (Runs[0] + Runs[1] + Runs[3] + Runs[4]) * Scale / 4;
+		const int32 Err = Avg * 3 / 4;
+
+		for (int32 i = 0; i < 5; ++i)
+		{
+			if (Runs[i] * Scale < Check[i] * Avg - Err || Runs[i] * Scale > Check[i] * Avg + Err)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Same test down the column through (X, Y), which sits in the centre dark run.
+	static bool CheckColumn(const uint8* Luma, int32 H, int32 Stride, int32 X, int32 Y, uint8 Threshold, int32 MaxRun)
+	{
+		auto IsDark = [Luma, Stride, X, Threshold](int32 Row) { return Luma[Row * Stride + X] < Threshold; };
+
+		// Walk out from the centre: Runs[2] is split between both directions.
+		int32 Runs[5] = {};
+
+		for (int32 Side = 0; Side < 2; ++Side)
+		{
+			const int32 Dir = Side ? 1 : -1;
+			int32 Row = Y;
+			bool bDark = true;
+
+			for (int32 Run = 0; Run < 3; ++Run)
+			{
+				int32 Len = 0;
+				while (Row >= 0 && Row < H && IsDark(Row) == bDark && Len <= MaxRun)
+				{
+					Row += Dir;
+					++Len;
+				}
+
+				if (Len == 0 || Len > MaxRun || ((Row < 0 || Row >= H) && Run < 2))
+				{
+					return false;
+				}
+
+				if (Run == 0)
+				{
+					Runs[2] += Len;
+				}
+				else
+				{
+					Runs[Side ? 2 + Run : 2 - Run] = Len;
+				}
+				bDark = !bDark;
+			}
+		}
+
+		// The centre pixel was counted on both walks.
+		Runs[2] -= 1;
+		return IsFinderRatio(Runs);
+	}
+}
+
+bool FQuircReader::HasFinderCandidates(const uint8* Luma, int32 W, int32 H, int32 Stride,
+                                       int32 Step, TArray<FIntPoint>* OutCandidates)
+{
+	using namespace QuircPrefilter;
+
+	if (OutCandidates)
+	{
+		OutCandidates->Reset();
+	}
+
+	if (!Luma || W <= 0 || H <= 0 || Stride < W)
+	{
+		return false;
+	}
+
+	Step = FMath::Max(1, Step);
+
+	const uint8 Threshold = SubsampledOtsu(Luma, W, H, Stride, Step);
+	const int32 NumWords = (W + 63) / 64;
+
+	TArray<uint64, TInlineAllocator<64>> Bits;
+	Bits.SetNumUninitialized(NumWords);
+
+	bool bAny = false;
+
+	for (int32 Y = 0; Y < H; Y += Step)
+	{
+		const uint8* Row = Luma + Y * Stride;
+		PackRow(Row, W, Threshold, Bits.GetData());
+
+		int32 Runs[5] = {};
+		int32 RunCount = 0;
+		int32 RunStart = 0;
+		bool bDark = (Bits[0] & 1) != 0;
+
+		for (;;)
+		{
+			const int32 X = NextTransition(Bits.GetData(), NumWords, W, RunStart, bDark);
+			if (X >= W)
+			{
+				break;
+			}
+
+			FMemory::Memmove(Runs, Runs + 1, sizeof(Runs[0]) * 4);
+			Runs[4] = X - RunStart;
+			RunStart = X;
+			++RunCount;
+			bDark = !bDark;
+
+			// The run that just ended was dark: dark-light-DARK-light-dark.
+			if (!bDark && RunCount >= 5 && IsFinderRatio(Runs))
+			{
+				const int32 CX = X - Runs[4] - Runs[3] - Runs[2] + Runs[2] / 2;
+				const int32 Total = Runs[0] + Runs[1] + Runs[2] + Runs[3] + Runs[4];
+
+				if (CheckColumn(Luma, H, Stride, CX, Y, Threshold, Total))
+				{
+					bAny = true;
+					if (!OutCandidates)
+					{
+						return true;
+					}
+					OutCandidates->Emplace(CX, Y);
+				}
+			}
+		}
+	}
+
+	return bAny;
+}
@@ -2,73 +2,413 @@
 // Copyright (c) 2025-2026 Yesid Fonseca
 
 #include "QuircReader.h"
-#include <string>
+#include "Async/ParallelFor.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
 
 extern "C" {
 	#include "quirc.h" 
 }
 
-bool FQuircReader::DecodeFromLuma(const uint8* Luma, int32 W, int32 H, int32 Stride,
-                                  TArray<FQRDetection>& Out) 
+// Runs quirc's finder-pattern row bands on the task graph.
+static void QuircParallelFor(void* /*UserData*/, int Count, quirc_parallel_func_t Func, void* Arg)
 {
-	Out.Reset();
+	ParallelFor(Count, [Func, Arg](int32 Index)
+	{
+		Func(Arg, Index);
+	});
+}
+
+// FQuircReader::SetTimingReject; read by every decode.
+static std::atomic<bool> bQuircTimingReject{ false };
+
+// One quirc decoder per thread, kept between calls so that frames of the same size
+// reuse its image, label and run buffers. Task graph workers live as long as the
+// engine, so a worker's decoder is only freed at shutdown.
+namespace QuircContext
+{
+	struct FContext
+	{
+		quirc* Q = nullptr;
+		int32 Width = 0;
+		int32 Height = 0;
+		bool bInUse = false;
+
+		~FContext()
+		{
+			if (Q)
+			{
+				quirc_destroy(Q);
+			}
+		}
+
+		quirc* Resize(int32 W, int32 H)
+		{
+			if (!Q)
+			{
+				Q = quirc_new();
+				if (!Q)
+				{
+					return nullptr;
+				}
+			}
+
+			if (Width != W || Height != H)
+			{
+				// quirc_resize leaves the decoder as it was on failure.
+				if (quirc_resize(Q, W, H) != 0)
+				{
+					return nullptr;
+				}
+				Width = W;
+				Height = H;
+			}
+
+			return Q;
+		}
+	};
+
+	// Borrows this thread's decoder for one image. A nested decode on the same
+	// thread (another task run while this one waits on its finder scan) gets a
+	// decoder of its own instead.
+	class FScopedDecoder
+	{
+	public:
+		FScopedDecoder(int32 W, int32 H)
+		{
+			thread_local FContext Context;
+
+			if (!Context.bInUse)
+			{
+				Owner = &Context;
+				Owner->bInUse = true;
+				Q = Owner->Resize(W, H);
+			}
+			else
+			{
+				Q = quirc_new();
+				if (Q && quirc_resize(Q, W, H) != 0)
+				{
+					quirc_destroy(Q);
+					Q = nullptr;
+				}
+			}
+		}
+
+		~FScopedDecoder()
+		{
+			if (Owner)
+			{
+				Owner->bInUse = false;
+			}
+			else if (Q)
+			{
+				quirc_destroy(Q);
+			}
+		}
+
+		quirc* Get() const { return Q; }
+
+	private:
+		FContext* Owner = nullptr;
+		quirc* Q = nullptr;
+	};
+}
+
+// Small LRU of decoded payloads keyed by the sampled cell grid. A code held
+// still in view samples to the same bits frame after frame, so the format/version
+// read and Reed-Solomon correction only run when the grid actually changes.
+namespace QuircDecodeCache
+{
+	static constexpr int32 MaxEntries = 16;
+
+	struct FEntry
+	{
+		uint32 Hash = 0;
+		int32 Size = 0;
+		TArray<uint8> Bitmap;
+		TArray<uint8> Payload;
+		uint64 LastUsed = 0;
+	};
+
+	struct FCache
+	{
+		FCriticalSection Lock;
+		TArray<FEntry> Entries;
+		uint64 Clock = 0;
+		FQuircDecodeCacheStats Stats;
+	};
+
+	static FCache& Get()
+	{
+		static FCache Cache;
+		return Cache;
+	}
+
+	static int32 BitmapBytes(const quirc_code& Code)
+	{
+		return (Code.size * Code.size + 7) / 8;
+	}
+
+	static uint32 HashCode(const quirc_code& Code)
+	{
+		return FCrc::MemCrc32(Code.cell_bitmap, BitmapBytes(Code), static_cast<uint32>(Code.size));
+	}
+
+	// On a hit, copies the payload into Out (QUIRC_MAX_PAYLOAD bytes).
+	static bool Find(const quirc_code& Code, uint32 Hash, uint8* Out, int32& OutLength)
+	{
+		FCache& Cache = Get();
+		FScopeLock ScopeLock(&Cache.Lock);
+
+		const int32 NumBytes = BitmapBytes(Code);
+		for (FEntry& Entry : Cache.Entries)
+		{
+			if (Entry.Hash == Hash && Entry.Size == Code.size &&
+			    FMemory::Memcmp(Entry.Bitmap.GetData(), Code.cell_bitmap, NumBytes) == 0)
+			{
+				Entry.LastUsed = ++Cache.Clock;
+				++Cache.Stats.Hits;
+				OutLength = Entry.Payload.Num();
+				FMemory::Memcpy(Out, Entry.Payload.GetData(), OutLength);
+				return true;
+			}
+		}
+
+		++Cache.Stats.Misses;
+		return false;
+	}
+
+	static void Add(const quirc_code& Code, uint32 Hash, const uint8* Payload, int32 Length)
+	{
+		FCache& Cache = Get();
+		FScopeLock ScopeLock(&Cache.Lock);
+
+		FEntry* Slot = nullptr;
+		if (Cache.Entries.Num() < MaxEntries)
+		{
+			Slot = &Cache.Entries.AddDefaulted_GetRef();
+		}
+		else
+		{
+			Slot = &Cache.Entries[0];
+			for (FEntry& Entry : Cache.Entries)
+			{
+				if (Entry.LastUsed < Slot->LastUsed)
+				{
+					Slot = &Entry;
+				}
+			}
+		}
+
+		Slot->Hash = Hash;
+		Slot->Size = Code.size;
+		Slot->Bitmap.SetNumUninitialized(BitmapBytes(Code), EAllowShrinking::No);
+		FMemory::Memcpy(Slot->Bitmap.GetData(), Code.cell_bitmap, Slot->Bitmap.Num());
+		Slot->Payload.SetNumUninitialized(Length, EAllowShrinking::No);
+		FMemory::Memcpy(Slot->Payload.GetData(), Payload, Length);
+		Slot->LastUsed = ++Cache.Clock;
+	}
+}
 
-	if (!Luma || W <= 0 || H <= 0 || Stride < W)
+FQuircDecodeCacheStats FQuircReader::GetDecodeCacheStats()
+{
+	QuircDecodeCache::FCache& Cache = QuircDecodeCache::Get();
+	FScopeLock ScopeLock(&Cache.Lock);
+	return Cache.Stats;
+}
+
+void FQuircReader::ResetDecodeCache()
+{
+	QuircDecodeCache::FCache& Cache = QuircDecodeCache::Get();
+	FScopeLock ScopeLock(&Cache.Lock);
+	Cache.Entries.Reset();
+	Cache.Clock = 0;
+	Cache.Stats = FQuircDecodeCacheStats();
+}
+
+void FQuircReader::SetTimingReject(bool bEnable)
+{
+	bQuircTimingReject.store(bEnable, std::memory_order_relaxed);
+}
+
+bool FQuircReader::GetTimingReject()
+{
+	return bQuircTimingReject.load(std::memory_order_relaxed);
+}
+
+// Decodes one image on the calling thread's decoder into Out. bParallelScan spreads
+// quirc's finder scan over the task graph; batches already run one image per task.
+static bool DecodeImage(const FQuircLumaImage& Image, bool bParallelScan, FQuircResultArena& Out)
+{
+	const int32 W = Image.Width;
+	const int32 H = Image.Height;
+
+	if (!Image.Luma || W <= 0 || H <= 0 || Image.Stride < W)
 	{
+		Out.BeginFrame();
 		return false;
 	}
 
-	quirc* Q = quirc_new();
+	QuircContext::FScopedDecoder Decoder(W, H);
+	quirc* Q = Decoder.Get();
 	if (!Q)
 	{
+		Out.BeginFrame();
 		return false;
 	}
 
-	bool bAny = false;
+	quirc_set_parallel_for(Q, bParallelScan ? &QuircParallelFor : nullptr, nullptr);
+	quirc_set_timing_reject(Q, bQuircTimingReject.load(std::memory_order_relaxed) ? 1 : 0);
 
-	if (quirc_resize(Q, W, H) == 0)
+	// Flood fill labels in the image buffer, so every pass starts from a fresh copy.
+	auto Scan = [&Image, Q, W, H](quirc_labeler_t Labeler)
 	{
+		quirc_set_labeler(Q, Labeler);
+
 		int iW = 0, iH = 0;
-		uint8_t* Img = quirc_begin(Q, &iW, &iH); 
-		if (Img && iW == W && iH == H)
+		uint8_t* Img = quirc_begin(Q, &iW, &iH);
+		if (!Img || iW != W || iH != H)
+		{
+			return false;
+		}
+
+		for (int y = 0; y < H; ++y)
+		{
+			FMemory::Memcpy(Img + y * W, Image.Luma + y * Image.Stride, W);
+		}
+
+		quirc_end(Q);
+		return true;
+	};
+
+	// Flood fill is much cheaper on typical frames, but textured backgrounds on large
+	// frames can fill its region table (QUIRC_MAX_REGIONS) before every finder pattern
+	// has been labelled. Only then pay for union-find, whose tables grow as needed.
+	bool bScanned = Scan(QUIRC_LABELER_FLOOD_FILL);
+	if (bScanned && quirc_regions_exhausted(Q))
+	{
+		bScanned = Scan(QUIRC_LABELER_UNION_FIND);
+	}
+	if (!bScanned)
+	{
+		Out.BeginFrame();
+		return false;
+	}
+
+	// Only touch the arena now: a nested decode run on this thread while
+	// quirc_end waited on its finder scan may have used the same scratch arena.
+	Out.BeginFrame();
+
+	bool bAny = false;
+
+	const int CodeCount = quirc_count(Q);
+	for (int i = 0; i < CodeCount; ++i)
+	{
+		quirc_code Code;
+		quirc_extract(Q, i, &Code);
+
+		if (Code.size <= 0)
+		{
+			continue;
+		}
+
+		// quirc_data is large; only its payload buffer is used on a cache hit.
+		quirc_data Data;
+		int32 Length = 0;
+
+		const uint32 Hash = QuircDecodeCache::HashCode(Code);
+		if (!QuircDecodeCache::Find(Code, Hash, Data.payload, Length))
 		{
-			for (int y = 0; y < H; ++y)
+			if (quirc_decode(&Code, &Data) != QUIRC_SUCCESS)
 			{
-				FMemory::Memcpy(Img + y * W, Luma + y * Stride, W);
+				continue;
 			}
 
-			quirc_end(Q);
+			Length = Data.payload_len;
+			QuircDecodeCache::Add(Code, Hash, Data.payload, Length);
+		}
 
-			const int CodeCount = quirc_count(Q);
-			for (int i = 0; i < CodeCount; ++i)
-			{
-				quirc_code Code;
-				quirc_data Data;
-				quirc_extract(Q, i, &Code);
+		FVector2D Corners[4];
+		for (int c = 0; c < 4; ++c)
+		{
+			Corners[c] = FVector2D(Image.Origin.X + Code.corners[c].x * Image.Scale,
+			                       Image.Origin.Y + Code.corners[c].y * Image.Scale);
+		}
 
-				if (quirc_decode(&Code, &Data) == QUIRC_SUCCESS)
-				{
-					FQRDetection R;
-
-					const std::string S(reinterpret_cast<const char*>(Data.payload),
-					                    static_cast<size_t>(Data.payload_len));
-					R.Text = UTF8_TO_TCHAR(S.c_str());
-
-					
-					R.Corners.Reserve(4);
-					for (int c = 0; c < 4; ++c)
-					{
-						R.Corners.Emplace(static_cast<float>(Code.corners[c].x),
-						                  static_cast<float>(Code.corners[c].y));
-					}
-
-					Out.Add(MoveTemp(R));
-					bAny = true;
-				}
-			}
+		if (!Out.Add(Data.payload, Length, Corners))
+		{
+			break;
 		}
+		bAny = true;
 	}
 
-	quirc_destroy(Q);
 	return bAny;
-}
\ No newline at end of file
+}
+
+// The TArray overloads go through an untracked arena kept per thread.
+static FQuircResultArena& ScratchArena()
+{
+	thread_local FQuircResultArena Arena(/*MaxDetections*/ 64, /*MaxPayloads*/ 64, /*MaxMissedFrames*/ 0, /*bTrackIds*/ false);
+	return Arena;
+}
+
+static bool DecodeImage(const FQuircLumaImage& Image, bool bParallelScan, TArray<FQRDetection>& Out)
+{
+	FQuircResultArena& Arena = ScratchArena();
+	const bool bAny = DecodeImage(Image, bParallelScan, Arena);
+	Out.Reset();
+	Arena.CopyTo(Out);
+	return bAny;
+}
+
+bool FQuircReader::DecodeFromLuma(const uint8* Luma, int32 W, int32 H, int32 Stride,
+                                  TArray<FQRDetection>& Out) 
+{
+	FQuircLumaImage Image;
+	Image.Luma = Luma;
+	Image.Width = W;
+	Image.Height = H;
+	Image.Stride = Stride;
+
+	return DecodeImage(Image, /*bParallelScan*/ true, Out);
+}
+
+bool FQuircReader::DecodeFromLuma(const uint8* Luma, int32 W, int32 H, int32 Stride,
+                                  FQuircResultArena& Out)
+{
+	FQuircLumaImage Image;
+	Image.Luma = Luma;
+	Image.Width = W;
+	Image.Height = H;
+	Image.Stride = Stride;
+
+	return DecodeImage(Image, /*bParallelScan*/ true, Out);
+}
+
+bool FQuircReader::DecodeFromLuma(const FQuircLumaImage& Image, FQuircResultArena& Out)
+{
+	return DecodeImage(Image, /*bParallelScan*/ true, Out);
+}
+
+int32 FQuircReader::DecodeBatch(TConstArrayView<FQuircLumaImage> Images, TArray<FQuircBatchResult>& Out)
+{
+	Out.Reset();
+	Out.SetNum(Images.Num());
+
+	// A lone image gets the banded finder scan instead.
+	const bool bParallelScan = Images.Num() == 1;
+
+	ParallelFor(Images.Num(), [&Images, &Out, bParallelScan](int32 Index)
+	{
+		Out[Index].SourceId = Images[Index].SourceId;
+		DecodeImage(Images[Index], bParallelScan, Out[Index].Detections);
+	});
+
+	int32 NumDetections = 0;
+	for (const FQuircBatchResult& Result : Out)
+	{
+		NumDetections += Result.Detections.Num();
+	}
+	return NumDetections;
+}
@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+#include "QuircReader.h"
+
+FQuircResultArena::FQuircResultArena(int32 InMaxDetections, int32 InMaxPayloads,
+                                     int32 InMaxMissedFrames, bool bInTrackIds)
+	: MaxMissedFrames(FMath::Max(0, InMaxMissedFrames))
+	, bTrackIds(bInTrackIds)
+{
+	const int32 MaxDetections = FMath::Max(1, InMaxDetections);
+
+	// Every detection of the current frame must be able to hold its payload.
+	Detections.SetNum(MaxDetections);
+	Payloads.SetNum(FMath::Max(MaxDetections, InMaxPayloads));
+	Tracks.SetNum(bTrackIds ? MaxDetections * 2 : 0);
+}
+
+TConstArrayView<uint8> FQuircResultArena::GetPayload(const FQuircArenaDetection& Detection) const
+{
+	return Payloads[Detection.PayloadIndex].Bytes;
+}
+
+const FString& FQuircResultArena::GetText(const FQuircArenaDetection& Detection)
+{
+	FInterned& Entry = Payloads[Detection.PayloadIndex];
+	if (!Entry.bHasText)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Entry.Bytes.GetData()), Entry.Bytes.Num());
+		Entry.Text.Reset(Converted.Length());
+		Entry.Text.AppendChars(Converted.Get(), Converted.Length());
+		Entry.bHasText = true;
+	}
+	return Entry.Text;
+}
+
+void FQuircResultArena::CopyTo(TArray<FQRDetection>& Out)
+{
+	Out.SetNum(NumDetections);
+
+	for (int32 i = 0; i < NumDetections; ++i)
+	{
+		const FQuircArenaDetection& Detection = Detections[i];
+		FQRDetection& R = Out[i];
+
+		if (R.Id == INDEX_NONE || R.Id != Detection.Id)
+		{
+			R.Text = GetText(Detection);
+		}
+		R.Id = Detection.Id;
+		R.bIsNew = Detection.bIsNew;
+
+		R.Corners.SetNumUninitialized(4);
+		for (int32 c = 0; c < 4; ++c)
+		{
+			R.Corners[c] = Detection.Corners[c];
+		}
+	}
+}
+
+void FQuircResultArena::MarkEmptyFrame()
+{
+	BeginFrame();
+}
+
+void FQuircResultArena::Reset()
+{
+	for (FInterned& Entry : Payloads)
+	{
+		Entry.Hash = 0;
+		Entry.Bytes.Reset();
+		Entry.Text.Reset();
+		Entry.bHasText = false;
+		Entry.LastUsedFrame = 0;
+	}
+	for (FTrack& Track : Tracks)
+	{
+		Track = FTrack();
+	}
+
+	// NextId keeps counting: CopyTo reuses the text of an entry with the same Id.
+	NumDetections = 0;
+	Frame = 0;
+}
+
+void FQuircResultArena::BeginFrame()
+{
+	++Frame;
+	NumDetections = 0;
+}
+
+bool FQuircResultArena::Add(const uint8* Payload, int32 Length, const FVector2D* Corners)
+{
+	if (NumDetections >= Detections.Num())
+	{
+		return false;
+	}
+
+	FQuircArenaDetection& Detection = Detections[NumDetections++];
+	Detection.PayloadIndex = Intern(Payload, Length);
+
+	FVector2D Center = FVector2D::ZeroVector;
+	for (int32 c = 0; c < 4; ++c)
+	{
+		Detection.Corners[c] = Corners[c];
+		Center += Corners[c] * 0.25;
+	}
+
+	if (!bTrackIds)
+	{
+		Detection.Id = INDEX_NONE;
+		Detection.bIsNew = false;
+		return true;
+	}
+
+	const double Radius = 0.5 * FMath::Max(FVector2D::Distance(Corners[0], Corners[2]),
+	                                       FVector2D::Distance(Corners[1], Corners[3]));
+
+	const int32 TrackIndex = MatchTrack(Detection.PayloadIndex, Center, Radius);
+	FTrack& Track = Tracks[TrackIndex];
+
+	Detection.bIsNew = Track.Id == INDEX_NONE;
+	if (Detection.bIsNew)
+	{
+		Track.Id = NextId++;
+		Track.PayloadIndex = Detection.PayloadIndex;
+	}
+
+	Track.Center = Center;
+	Track.Radius = Radius;
+	Track.LastSeenFrame = Frame;
+	Detection.Id = Track.Id;
+	return true;
+}
+
+int32 FQuircResultArena::Intern(const uint8* Payload, int32 Length)
+{
+	const uint32 Hash = FCrc::MemCrc32(Payload, Length);
+
+	int32 Oldest = 0;
+	for (int32 i = 0; i < Payloads.Num(); ++i)
+	{
+		FInterned& Entry = Payloads[i];
+		if (Entry.LastUsedFrame != 0 && Entry.Hash == Hash && Entry.Bytes.Num() == Length &&
+		    FMemory::Memcmp(Entry.Bytes.GetData(), Payload, Length) == 0)
+		{
+			Entry.LastUsedFrame = Frame;
+			return i;
+		}
+
+		if (Entry.LastUsedFrame < Payloads[Oldest].LastUsedFrame)
+		{
+			Oldest = i;
+		}
+	}
+
+	// Least recently seen payload; it can't belong to this frame since there are
+	// at least as many entries as detections per frame. Tracks that pointed at it
+	// are dropped so that an Id never changes payload.
+	for (FTrack& Track : Tracks)
+	{
+		if (Track.PayloadIndex == Oldest)
+		{
+			Track = FTrack();
+		}
+	}
+
+	FInterned& Entry = Payloads[Oldest];
+	Entry.Hash = Hash;
+	Entry.Bytes.SetNumUninitialized(Length, EAllowShrinking::No);
+	FMemory::Memcpy(Entry.Bytes.GetData(), Payload, Length);
+	Entry.bHasText = false;
+	Entry.LastUsedFrame = Frame;
+	return Oldest;
+}
+
+int32 FQuircResultArena::MatchTrack(int32 PayloadIndex, const FVector2D& Center, double Radius)
+{
+	// Same payload, seen recently, not yet claimed this frame, and close to where
+	// it was: a code rarely moves more than its own size between frames.
+	int32 Best = INDEX_NONE;
+	double BestDistance = 0.0;
+	int32 Free = INDEX_NONE;
+
+	for (int32 i = 0; i < Tracks.Num(); ++i)
+	{
+		const FTrack& Track = Tracks[i];
+		const bool bLive = Track.Id != INDEX_NONE && Track.LastSeenFrame + MaxMissedFrames + 1 >= Frame;
+
+		if (!bLive)
+		{
+			if (Free == INDEX_NONE || Track.LastSeenFrame < Tracks[Free].LastSeenFrame)
+			{
+				Free = i;
+			}
+			continue;
+		}
+
+		if (Track.PayloadIndex != PayloadIndex || Track.LastSeenFrame == Frame)
+		{
+			continue;
+		}
+
+		const double Distance = FVector2D::Distance(Track.Center, Center);
+		if (Distance <= 2.0 * FMath::Max(Radius, Track.Radius) && (Best == INDEX_NONE || Distance < BestDistance))
+		{
+			Best = i;
+			BestDistance = Distance;
+		}
+	}
+
+	if (Best != INDEX_NONE)
+	{
+		return Best;
+	}
+
+	// New code: a free slot, or else the live track seen longest ago (never one
+	// already claimed this frame, since there are twice as many tracks as detections).
+	if (Free == INDEX_NONE)
+	{
+		Free = 0;
+		for (int32 i = 1; i < Tracks.Num(); ++i)
+		{
+			if (Tracks[i].LastSeenFrame < Tracks[Free].LastSeenFrame)
+			{
+				Free = i;
+			}
+		}
+	}
+
+	Tracks[Free] = FTrack();
+	return Free;
+}
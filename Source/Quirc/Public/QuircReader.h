@@ -15,21 +15,220 @@ public:
 	FString Text;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Quirc QRCode Corners")
 	TArray<FVector2D> Corners; 
+	/** Identificador estable entre frames (INDEX_NONE sin seguimiento). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Quirc QRCode")
+	int32 Id = INDEX_NONE;
+	/** true el primer frame en que aparece este Id. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Quirc QRCode")
+	bool bIsNew = false;
 };
 
+/** Detección dentro de un FQuircResultArena. */
+struct FQuircArenaDetection
+{
+	/** Identificador estable: el mismo código seguido entre frames conserva su Id. */
+	int32 Id = INDEX_NONE;
+	/** true el primer frame en que aparece este Id. */
+	bool bIsNew = false;
+	/** Payload internado; ver FQuircResultArena::GetPayload / GetText. */
+	int32 PayloadIndex = INDEX_NONE;
+	FVector2D Corners[4];
+};
+
+/**
+ * Resultados de decodificación sin asignaciones por frame. Las tablas se reservan
+ * al construir; los payloads se internan como bytes UTF-8 y sólo se convierten a
+ * FString cuando se piden (una vez por payload). Cada detección se empareja con
+ * las del frame anterior por payload y posición, así que conserva su Id mientras
+ * siga a la vista. Usa un arena por flujo de cámara.
+ */
+class QUIRC_API FQuircResultArena
+{
+public:
+	/**
+	 * @param MaxDetections   Detecciones por frame (las sobrantes se descartan)
+	 * @param MaxPayloads     Payloads internados (>= MaxDetections)
+	 * @param MaxMissedFrames Frames que un código puede faltar sin perder su Id
+	 * @param bTrackIds       false: sin seguimiento, Id = INDEX_NONE
+	 */
+	explicit FQuircResultArena(int32 MaxDetections = 16, int32 MaxPayloads = 32,
+	                           int32 MaxMissedFrames = 5, bool bTrackIds = true);
+
+	int32 Num() const { return NumDetections; }
+	const FQuircArenaDetection& operator[](int32 Index) const { return Detections[Index]; }
+
+	/** Bytes UTF-8 del payload (sin terminador). */
+	TConstArrayView<uint8> GetPayload(const FQuircArenaDetection& Detection) const;
+
+	/** Texto del payload, convertido la primera vez que se pide. */
+	const FString& GetText(const FQuircArenaDetection& Detection);
+
+	/**
+	 * Vuelca el frame a FQRDetection reutilizando los elementos de Out: un Id que ya
+	 * estaba en la misma posición no vuelve a copiar su texto.
+	 */
+	void CopyTo(TArray<FQRDetection>& Out);
+
+	/** Frame sin decodificar (p. ej. descartado por el prefiltro): vacía y envejece el seguimiento. */
+	void MarkEmptyFrame();
+
+	/**
+	 * Olvida seguimiento y payloads. Los Id siguen contando desde donde iban, así
+	 * que un Id de antes del Reset nunca se confunde en CopyTo con uno nuevo.
+	 */
+	void Reset();
+
+	/** Usados por FQuircReader: abre un frame y añade sus detecciones (false si está lleno). */
+	void BeginFrame();
+	bool Add(const uint8* Payload, int32 Length, const FVector2D* Corners);
+
+private:
+	struct FInterned
+	{
+		uint32 Hash = 0;
+		TArray<uint8> Bytes;
+		FString Text;
+		bool bHasText = false;
+		uint64 LastUsedFrame = 0;
+	};
+
+	struct FTrack
+	{
+		int32 Id = INDEX_NONE;
+		int32 PayloadIndex = INDEX_NONE;
+		FVector2D Center = FVector2D::ZeroVector;
+		double Radius = 0.0;
+		uint64 LastSeenFrame = 0;
+	};
+
+	int32 Intern(const uint8* Payload, int32 Length);
+	int32 MatchTrack(int32 PayloadIndex, const FVector2D& Center, double Radius);
+
+	TArray<FQuircArenaDetection> Detections;
+	TArray<FInterned> Payloads;
+	TArray<FTrack> Tracks;
+	int32 NumDetections = 0;
+	int32 MaxMissedFrames = 0;
+	bool bTrackIds = true;
+	uint64 Frame = 0;
+	int32 NextId = 0;
+};
+
+
+/** Contadores de la caché de payloads decodificados. */
+struct FQuircDecodeCacheStats
+{
+	uint64 Hits = 0;
+	uint64 Misses = 0;
+
+	double GetHitRate() const
+	{
+		const uint64 Total = Hits + Misses;
+		return Total > 0 ? static_cast<double>(Hits) / static_cast<double>(Total) : 0.0;
+	}
+};
+
+/** Una imagen de entrada para FQuircReader::DecodeBatch (cámara, ROI o nivel de pirámide). */
+struct FQuircLumaImage
+{
+	/** Plano Y 8-bit; no se copia, debe seguir vivo durante la llamada. */
+	const uint8* Luma = nullptr;
+	int32 Width = 0;
+	int32 Height = 0;
+	/** Bytes por fila (>= Width). */
+	int32 Stride = 0;
+
+	/** Etiqueta libre del llamador, se copia tal cual al resultado. */
+	int32 SourceId = 0;
+
+	/**
+	 * Transformación de esquinas a coordenadas de la imagen completa:
+	 * Corner = Origin + Corner * Scale. Para un ROI, Origin es su esquina superior
+	 * izquierda; para un nivel de pirámide reducido a la mitad, Scale = 2.
+	 */
+	FVector2D Origin = FVector2D::ZeroVector;
+	float Scale = 1.0f;
+};
+
+/** Resultado de una imagen de DecodeBatch. */
+struct FQuircBatchResult
+{
+	int32 SourceId = 0;
+	TArray<FQRDetection> Detections;
+};
 
 class QUIRC_API FQuircReader
 {
 public:
 	/**
 	 * Decodifica QR a partir de un plano Luma (Y) 8-bit o gray scale.
+	 * Desde 640x480 usa el etiquetado union-find, sin límite de regiones, para no
+	 * perder finder patterns en escenas con mucha textura.
+	 * Reutiliza un contexto quirc por hilo: frames del mismo tamaño no vuelven a
+	 * reservar memoria.
 	 * @param Luma   Puntero al buffer Y (no nulo)
 	 * @param Width  Ancho en píxeles
 	 * @param Height Alto en píxeles
 	 * @param Stride Bytes por fila en Luma (>= Width)
-	 * @param Out    Resultados (limpia y rellena)
+	 * @param Out    Resultados (limpia y rellena); sin seguimiento, Id = INDEX_NONE
 	 * @return true si encontró al menos un QR válido.
 	 */
 	static bool DecodeFromLuma(const uint8* Luma, int32 Width, int32 Height, int32 Stride,
 	                           TArray<FQRDetection>& Out) ;
+
+	/**
+	 * Igual que la anterior, pero escribe en un arena reutilizable: sin asignaciones
+	 * por frame y con Id estables entre frames.
+	 * @return true si encontró al menos un QR válido.
+	 */
+	static bool DecodeFromLuma(const uint8* Luma, int32 Width, int32 Height, int32 Stride,
+	                           FQuircResultArena& Out);
+
+	/**
+	 * Igual, para un ROI o una imagen reducida: las esquinas se llevan a la imagen
+	 * completa con Image.Origin / Image.Scale antes de emparejar los Id.
+	 */
+	static bool DecodeFromLuma(const FQuircLumaImage& Image, FQuircResultArena& Out);
+
+	/**
+	 * Decodifica varias imágenes en paralelo sobre el task graph. Cada hilo usa su
+	 * propio contexto quirc, que se conserva entre llamadas (igual que en
+	 * DecodeFromLuma), así que varias cámaras o ROIs escalan con los núcleos.
+	 * @param Images Imágenes de entrada; las inválidas dan un resultado vacío
+	 * @param Out    Un resultado por imagen, en el mismo orden y con su SourceId
+	 * @return Número total de QR decodificados.
+	 */
+	static int32 DecodeBatch(TConstArrayView<FQuircLumaImage> Images, TArray<FQuircBatchResult>& Out);
+
+	/**
+	 * Estadísticas de la caché de decodificación. Una rejilla de celdas idéntica
+	 * a una ya decodificada (código estático frente a la cámara) reutiliza el texto
+	 * sin volver a pasar por Reed-Solomon.
+	 */
+	static FQuircDecodeCacheStats GetDecodeCacheStats();
+
+	/** Vacía la caché y pone a cero los contadores. */
+	static void ResetDecodeCache();
+
+	/**
+	 * Descarta una rejilla antes de ajustar su perspectiva si sus patrones de timing
+	 * puntúan por debajo de un quinto del máximo (quirc_set_timing_reject). Ahorra el
+	 * ajuste en rejillas formadas con capstones de códigos vecinos, pero puede perder
+	 * códigos reales muy borrosos o con reflejos. Desactivado por defecto; afecta a
+	 * todas las llamadas siguientes, en cualquier hilo.
+	 */
+	static void SetTimingReject(bool bEnable);
+	static bool GetTimingReject();
+
+	/**
+	 * Prefiltro barato "¿hay un QR?". Busca la secuencia 1:1:3:1:1 de los finder
+	 * patterns en una de cada Step filas (umbral Otsu sobre una muestra submuestreada)
+	 * y confirma cada acierto con el mismo test en vertical. Cuesta una fracción de
+	 * DecodeFromLuma; si devuelve false no hace falta decodificar el frame.
+	 * @param Step          Separación entre filas muestreadas (>= 1)
+	 * @param OutCandidates Opcional: centros (px) de los finder patterns candidatos
+	 * @return true si hay al menos un candidato.
+	 */
+	static bool HasFinderCandidates(const uint8* Luma, int32 Width, int32 Height, int32 Stride,
+	                                int32 Step = 4, TArray<FIntPoint>* OutCandidates = nullptr);
 };
\ No newline at end of file
@@ -12,5 +12,12 @@ public class Quirc : ModuleRules
 
         PublicIncludePaths.Add(Path.Combine(ModuleDirectory, "Public"));
 		PrivateIncludePaths.Add(Path.Combine(ModuleDirectory, "ThirdParty", "lib"));
+
+        // QuircBenchmark (editor) llama a la API C de quirc: en builds modulares vive en otra DLL.
+        if (Target.LinkType == TargetLinkType.Modular)
+        {
+            PublicDefinitions.Add("QUIRC_SHARED_LIBRARY=1");
+            PrivateDefinitions.Add("QUIRC_BUILDING_LIBRARY=1");
+        }
     }
 }
\ No newline at end of file
@@ -19,6 +19,18 @@
 #include <string.h>
 #include <stdlib.h>
 
+#if !defined(QUIRC_NO_SIMD)
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define QUIRC_RS_NEON
+#define QUIRC_RS_SIMD
+#elif defined(__SSSE3__) || defined(__AVX__)
+#include <tmmintrin.h>
+#define QUIRC_RS_SSSE3
+#define QUIRC_RS_SIMD
+#endif
+#endif
+
 #define MAX_POLY       64
 
 /************************************************************************
@@ -149,7 +161,8 @@ static void poly_add(uint8_t *dst, const uint8_t *src, uint8_t c,
 	}
 }
 
-static uint8_t poly_eval(const uint8_t *s, uint8_t x,
+/* Evaluate the first n coefficients of s at x */
+static uint8_t poly_eval(const uint8_t *s, int n, uint8_t x,
 			 const struct galois_field *gf)
 {
 	int i;
@@ -159,7 +172,7 @@ static uint8_t poly_eval(const uint8_t *s, uint8_t x,
 	if (!x)
 		return s[0];
 
-	for (i = 0; i < MAX_POLY; i++) {
+	for (i = 0; i < n; i++) {
 		uint8_t c = s[i];
 
 		if (!c)
@@ -233,28 +246,144 @@ static void berlekamp_massey(const uint8_t *s, int N,
  * Generator polynomial for GF(2^8) is x^8 + x^4 + x^3 + x^2 + 1
  */
 
-static int block_syndromes(const uint8_t *data, int bs, int npar, uint8_t *s)
+#if defined(QUIRC_RS_SIMD)
+
+/* Below this size the table setup and lane folding cost more than the
+ * scalar loop saves.
+ */
+#define RS_SIMD_MIN_BLOCK	48
+
+/* Multiply v by alpha^log_c, 0 <= log_c < 255 */
+static inline uint8_t gf256_mul_log(uint8_t v, int log_c)
 {
-	int nonzero = 0;
-	int i;
+	int e;
 
-	memset(s, 0, MAX_POLY);
+	if (!v)
+		return 0;
 
-	for (i = 0; i < npar; i++) {
-		int j;
+	e = gf256_log[v] + log_c;
+	if (e >= 255)
+		e -= 255;
 
-		for (j = 0; j < bs; j++) {
-			uint8_t c = data[bs - j - 1];
+	return gf256_exp[e];
+}
 
-			if (!c)
-				continue;
+/* Split multiplication tables for alpha^log_c: the product with v is
+ * lo[v & 15] ^ hi[v >> 4]. Each table fits a 16-byte shuffle register.
+ */
+static void gf256_split_tables(int log_c, uint8_t *lo, uint8_t *hi)
+{
+	int n;
+
+	for (n = 0; n < 16; n++) {
+		lo[n] = gf256_mul_log(n, log_c);
+		hi[n] = gf256_mul_log(n << 4, log_c);
+	}
+}
+
+/* Evaluate the received block at alpha^i, sixteen coefficients at a time.
+ *
+ * The block is viewed as sixteen interleaved polynomials in x^16. Each
+ * lane runs Horner's rule with the same multiplier alpha^(16i), which
+ * is a single table shuffle per nibble, and the lanes are combined at
+ * the end with their x^(15 - l) offsets. Leading zero padding makes the
+ * block length a multiple of 16 without changing the result.
+ */
+static uint8_t block_syndrome_simd(const uint8_t *data, int bs, int i)
+{
+	uint8_t lo[16];
+	uint8_t hi[16];
+	uint8_t lanes[16];
+	const int pad = (16 - (bs & 15)) & 15;
+	uint8_t sum = 0;
+	int k;
+	int l;
+
+	gf256_split_tables((16 * i) % 255, lo, hi);
+
+	memset(lanes, 0, sizeof(lanes));
+	memcpy(lanes + pad, data, 16 - pad);
+	data += 16 - pad;
 
-			s[i] ^= gf256_exp[((int)gf256_log[c] +
-				    i * j) % 255];
+#if defined(QUIRC_RS_NEON)
+	{
+		const uint8x16_t tlo = vld1q_u8(lo);
+		const uint8x16_t thi = vld1q_u8(hi);
+		const uint8x16_t mask = vdupq_n_u8(0x0f);
+		uint8x16_t h = vld1q_u8(lanes);
+
+		for (k = 16 - pad; k < bs; k += 16, data += 16) {
+			const uint8x16_t p =
+			    veorq_u8(vqtbl1q_u8(tlo, vandq_u8(h, mask)),
+				     vqtbl1q_u8(thi, vshrq_n_u8(h, 4)));
+
+			h = veorq_u8(p, vld1q_u8(data));
+		}
+
+		vst1q_u8(lanes, h);
+	}
+#else
+	{
+		const __m128i tlo = _mm_loadu_si128((const __m128i *)lo);
+		const __m128i thi = _mm_loadu_si128((const __m128i *)hi);
+		const __m128i mask = _mm_set1_epi8(0x0f);
+		__m128i h = _mm_loadu_si128((const __m128i *)lanes);
+
+		for (k = 16 - pad; k < bs; k += 16, data += 16) {
+			const __m128i p = _mm_xor_si128(
+			    _mm_shuffle_epi8(tlo, _mm_and_si128(h, mask)),
+			    _mm_shuffle_epi8(thi, _mm_and_si128(
+				_mm_srli_epi16(h, 4), mask)));
+
+			h = _mm_xor_si128(p,
+			    _mm_loadu_si128((const __m128i *)data));
 		}
 
-		if (s[i])
-			nonzero = 1;
+		_mm_storeu_si128((__m128i *)lanes, h);
+	}
+#endif
+
+	for (l = 0; l < 16; l++)
+		sum ^= gf256_mul_log(lanes[l], (i * (15 - l)) % 255);
+
+	return sum;
+}
+
+#endif
+
+static uint8_t block_syndrome(const uint8_t *data, int bs, int i)
+{
+	uint8_t sum = 0;
+	int j;
+
+	for (j = 0; j < bs; j++) {
+		uint8_t c = data[bs - j - 1];
+
+		if (!c)
+			continue;
+
+		sum ^= gf256_exp[((int)gf256_log[c] + i * j) % 255];
+	}
+
+	return sum;
+}
+
+static int block_syndromes(const uint8_t *data, int bs, int npar, uint8_t *s)
+{
+	int nonzero = 0;
+	int i;
+
+	memset(s, 0, MAX_POLY);
+
+	for (i = 0; i < npar; i++) {
+#if defined(QUIRC_RS_SIMD)
+		if (bs >= RS_SIMD_MIN_BLOCK)
+			s[i] = block_syndrome_simd(data, bs, i);
+		else
+#endif
+			s[i] = block_syndrome(data, bs, i);
+
+		nonzero |= s[i];
 	}
 
 	return nonzero;
@@ -299,6 +428,7 @@ static quirc_decode_error_t correct_block(uint8_t *data,
 	uint8_t sigma[MAX_POLY];
 	uint8_t sigma_deriv[MAX_POLY];
 	uint8_t omega[MAX_POLY];
+	int sigma_len;
 	int i;
 
 	/* Compute syndrome vector */
@@ -307,6 +437,13 @@ static quirc_decode_error_t correct_block(uint8_t *data,
 
 	berlekamp_massey(s, npar, &gf256, sigma);
 
+	/* The Chien search below evaluates sigma at every position, so
+	 * only walk its non-zero terms.
+	 */
+	sigma_len = MAX_POLY;
+	while (sigma_len > 1 && !sigma[sigma_len - 1])
+		sigma_len--;
+
 	/* Compute derivative of sigma */
 	memset(sigma_deriv, 0, MAX_POLY);
 	for (i = 0; i + 1 < MAX_POLY; i += 2)
@@ -319,9 +456,10 @@ static quirc_decode_error_t correct_block(uint8_t *data,
 	for (i = 0; i < ecc->bs; i++) {
 		uint8_t xinv = gf256_exp[255 - i];
 
-		if (!poly_eval(sigma, xinv, &gf256)) {
-			uint8_t sd_x = poly_eval(sigma_deriv, xinv, &gf256);
-			uint8_t omega_x = poly_eval(omega, xinv, &gf256);
+		if (!poly_eval(sigma, sigma_len, xinv, &gf256)) {
+			uint8_t sd_x = poly_eval(sigma_deriv, MAX_POLY, xinv,
+						 &gf256);
+			uint8_t omega_x = poly_eval(omega, MAX_POLY, xinv, &gf256);
 			uint8_t error = gf256_exp[(255 - gf256_log[sd_x] +
 						   gf256_log[omega_x]) % 255];
 
@@ -345,26 +483,30 @@ static quirc_decode_error_t correct_block(uint8_t *data,
 #define FORMAT_SYNDROMES        (FORMAT_MAX_ERROR * 2)
 #define FORMAT_BITS             15
 
+/* Syndromes are linear in the received bits. Entry j holds the
+ * contribution of bit j to S_1 .. S_6, one nibble each.
+ */
+static const uint32_t format_syndrome_bits[FORMAT_BITS] = {
+	0x111111, 0xc63842, 0xf75c34, 0x81fac8, 0xa62f53,
+	0x176176, 0xc1a8fc, 0xf6dc9b, 0x874a25, 0xa1cf8a,
+	0x167167, 0xc798be, 0xf18caf, 0x86baed, 0xa7efd9
+};
+
 static int format_syndromes(uint16_t u, uint8_t *s)
 {
+	uint32_t packed = 0;
 	int i;
-	int nonzero = 0;
 
 	memset(s, 0, MAX_POLY);
 
-	for (i = 0; i < FORMAT_SYNDROMES; i++) {
-		int j;
-
-		s[i] = 0;
-		for (j = 0; j < FORMAT_BITS; j++)
-			if (u & (1 << j))
-				s[i] ^= gf16_exp[((i + 1) * j) % 15];
+	for (i = 0; i < FORMAT_BITS; i++)
+		if (u & (1 << i))
+			packed ^= format_syndrome_bits[i];
 
-		if (s[i])
-			nonzero = 1;
-	}
+	for (i = 0; i < FORMAT_SYNDROMES; i++)
+		s[i] = (packed >> (i * 4)) & 0xf;
 
-	return nonzero;
+	return packed != 0;
 }
 
 static quirc_decode_error_t correct_format(uint16_t *f_ret)
@@ -384,7 +526,7 @@ static quirc_decode_error_t correct_format(uint16_t *f_ret)
 
 	/* Now, find the roots of the polynomial */
 	for (i = 0; i < 15; i++)
-		if (!poly_eval(sigma, gf16_exp[15 - i], &gf16))
+		if (!poly_eval(sigma, MAX_POLY, gf16_exp[15 - i], &gf16))
 			u ^= (1 << i);
 
 	if (format_syndromes(u, s))
@@ -25,6 +25,30 @@
 #endif // QUIRC_USE_TGMATH
 #include "quirc_internal.h"
 
+/* Two-lane double precision perspective mapping for grid fitness. Only
+ * used when quirc_float_t is double, so results match the scalar path.
+ */
+#if !defined(QUIRC_NO_SIMD) && !defined(QUIRC_FLOAT_TYPE)
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define QUIRC_PERSPECTIVE_NEON
+#elif defined(__SSE2__) || defined(_M_X64) || \
+	(defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define QUIRC_PERSPECTIVE_SSE2
+#endif
+#endif
+
+/* Clang contracts a*b + c into an FMA on arm64 (-ffp-contract=on), which
+ * rounds once instead of twice. The NEON intrinsics below are never fused,
+ * so with contraction the scalar perspective_map() could land on the other
+ * side of a .5 and map a sample one pixel away. Keep the whole file
+ * unfused so both paths compute the same doubles.
+ */
+#if defined(QUIRC_PERSPECTIVE_NEON) && defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
 /************************************************************************
  * Linear algebra routines
  */
@@ -284,6 +308,187 @@ static void flood_fill_seed(struct quirc *q,
 	}
 }
 
+/************************************************************************
+ * Bit-packed binary image
+ */
+
+/* Return the first x' >= x on the row whose colour differs from `color',
+ * or w if the rest of the row has that colour. Whole words of a single
+ * colour are skipped at once.
+ */
+static int next_transition(const struct quirc *q, const uint64_t *row,
+			   int x, int color)
+{
+	const uint64_t flip = color ? ~(uint64_t)0 : 0;
+	const int num_words = q->bits_stride;
+	int i = x >> 6;
+	uint64_t word = (row[i] ^ flip) & (~(uint64_t)0 << (x & 63));
+
+	while (!word) {
+		if (++i >= num_words)
+			return q->w;
+		word = row[i] ^ flip;
+	}
+
+	x = (i << 6) + quirc_ctz64(word);
+	return x < q->w ? x : q->w;
+}
+
+/************************************************************************
+ * Run-length union-find labelling
+ */
+
+static int run_find(struct quirc_run *runs, int i)
+{
+	while (runs[i].parent != i) {
+		runs[i].parent = runs[runs[i].parent].parent;
+		i = runs[i].parent;
+	}
+
+	return i;
+}
+
+/* Join two components, keeping the lower run index as the root so that
+ * every root is the first run of its component in raster order.
+ */
+static void run_union(struct quirc_run *runs, int a, int b)
+{
+	a = run_find(runs, a);
+	b = run_find(runs, b);
+
+	if (a < b)
+		runs[b].parent = a;
+	else if (b < a)
+		runs[a].parent = b;
+}
+
+static int push_run(struct quirc *q, int y, int left, int right)
+{
+	struct quirc_run *r;
+
+	if (q->num_runs >= q->max_runs) {
+		int max = q->max_runs ? q->max_runs * 2 : 4096;
+		struct quirc_run *grown = realloc(q->runs, sizeof(*grown) * max);
+
+		if (!grown)
+			return -1;
+
+		q->runs = grown;
+		q->max_runs = max;
+	}
+
+	r = &q->runs[q->num_runs];
+	r->y = y;
+	r->left = left;
+	r->right = right;
+	r->parent = q->num_runs;
+	r->next = -1;
+
+	return q->num_runs++;
+}
+
+/* Label every 4-connected black component of the binarized image. Runs
+ * of each row are joined with the overlapping runs of the previous row,
+ * then each component's runs are chained from its root and its area is
+ * accumulated. Returns -1 if the run table could not be allocated.
+ */
+static int label_runs(struct quirc *q)
+{
+	int prev_begin = 0;
+	int prev_end = 0;
+	int x, y, i;
+
+	if (q->max_row_runs < q->h + 1) {
+		int *grown = realloc(q->row_runs, sizeof(*grown) * (q->h + 1));
+
+		if (!grown)
+			return -1;
+
+		q->row_runs = grown;
+		q->max_row_runs = q->h + 1;
+	}
+
+	q->num_runs = 0;
+
+	for (y = 0; y < q->h; y++) {
+		const uint64_t *row = q->bits + y * q->bits_stride;
+		int p = prev_begin;
+
+		q->row_runs[y] = q->num_runs;
+
+		x = 0;
+		while (x < q->w) {
+			int left, cur, k;
+
+			left = next_transition(q, row, x, 0);
+			if (left >= q->w)
+				break;
+
+			x = next_transition(q, row, left, 1);
+
+			cur = push_run(q, y, left, x - 1);
+			if (cur < 0)
+				return -1;
+
+			/* Skip runs above that end before this one starts.
+			 * They can't touch any later run on this row either.
+			 */
+			while (p < prev_end && q->runs[p].right < left)
+				p++;
+
+			for (k = p; k < prev_end && q->runs[k].left < x; k++)
+				run_union(q->runs, k, cur);
+		}
+
+		prev_begin = q->row_runs[y];
+		prev_end = q->num_runs;
+	}
+
+	q->row_runs[q->h] = q->num_runs;
+
+	for (i = 0; i < q->num_runs; i++) {
+		struct quirc_run *r = &q->runs[i];
+		const int root = run_find(q->runs, i);
+		struct quirc_run *rr = &q->runs[root];
+
+		r->parent = root;
+
+		if (root == i) {
+			rr->tail = i;
+			rr->count = 0;
+			rr->region = -1;
+		} else {
+			q->runs[rr->tail].next = i;
+			rr->tail = i;
+		}
+
+		rr->count += r->right - r->left + 1;
+	}
+
+	return 0;
+}
+
+/* Return the index of the run covering (x, y), or -1 for white pixels. */
+static int find_run(const struct quirc *q, int x, int y)
+{
+	int lo = q->row_runs[y];
+	int hi = q->row_runs[y + 1] - 1;
+
+	while (lo <= hi) {
+		const int mid = (lo + hi) >> 1;
+		const struct quirc_run *r = &q->runs[mid];
+
+		if (x < r->left)
+			hi = mid - 1;
+		else if (x > r->right)
+			lo = mid + 1;
+		else
+			return mid;
+	}
+
+	return -1;
+}
+
 /************************************************************************
  * Adaptive thresholding
  */
@@ -344,6 +549,82 @@ static void area_count(void *user_data, int y, int left, int right)
 	((struct quirc_region *)user_data)->count += right - left + 1;
 }
 
+/* Make room for `needed' entries in a table that starts at `initial'
+ * entries and doubles from there. Returns the (possibly moved) table, or
+ * NULL if it can't grow, in which case the old table is still valid and
+ * the caller treats it as full.
+ */
+static void *grow_table(void *table, int *max, int needed, int initial,
+			size_t size)
+{
+	int n = *max ? *max : initial;
+	void *grown;
+
+	while (n < needed)
+		n *= 2;
+
+	if (table && n == *max)
+		return table;
+
+	grown = realloc(table, size * n);
+	if (grown)
+		*max = n;
+
+	return grown;
+}
+
+/* Flood fill stores region codes in the pixel plane, so it is limited
+ * to QUIRC_MAX_REGIONS. Run labels have no such limit.
+ */
+static int new_region(struct quirc *q)
+{
+	struct quirc_region *grown;
+
+	if (!q->runs_valid && q->num_regions >= QUIRC_MAX_REGIONS) {
+		q->regions_exhausted = 1;
+		return -1;
+	}
+
+	grown = grow_table(q->regions, &q->max_regions, q->num_regions + 1,
+			   QUIRC_MAX_REGIONS, sizeof(*grown));
+	if (!grown)
+		return -1;
+
+	q->regions = grown;
+	return q->num_regions++;
+}
+
+static int region_code_runs(struct quirc *q, int x, int y)
+{
+	struct quirc_region *box;
+	struct quirc_run *root;
+	int run = find_run(q, x, y);
+	int region;
+
+	if (run < 0)
+		return -1;
+
+	root = &q->runs[q->runs[run].parent];
+	if (root->region >= 0)
+		return root->region;
+
+	region = new_region(q);
+	if (region < 0)
+		return -1;
+
+	box = &q->regions[region];
+
+	memset(box, 0, sizeof(*box));
+
+	box->seed.x = x;
+	box->seed.y = y;
+	box->count = root->count;
+	box->capstone = -1;
+	root->region = region;
+
+	return region;
+}
+
 static int region_code(struct quirc *q, int x, int y)
 {
 	int pixel;
@@ -353,6 +634,9 @@ static int region_code(struct quirc *q, int x, int y)
 	if (x < 0 || y < 0 || x >= q->w || y >= q->h)
 		return -1;
 
+	if (q->runs_valid)
+		return region_code_runs(q, x, y);
+
 	pixel = q->pixels[y * q->w + x];
 
 	if (pixel >= QUIRC_PIXEL_REGION)
@@ -361,11 +645,11 @@ static int region_code(struct quirc *q, int x, int y)
 	if (pixel == QUIRC_PIXEL_WHITE)
 		return -1;
 
-	if (q->num_regions >= QUIRC_MAX_REGIONS)
+	region = new_region(q);
+	if (region < 0)
 		return -1;
 
-	region = q->num_regions;
-	box = &q->regions[q->num_regions++];
+	box = &q->regions[region];
 
 	memset(box, 0, sizeof(*box));
 
@@ -378,6 +662,34 @@ static int region_code(struct quirc *q, int x, int y)
 	return region;
 }
 
+/* Visit every span of a labelled region. With flood fill labelling the
+ * region is repainted from `from' to `to'; the union-find labeller walks
+ * the component's runs and leaves the pixel buffer untouched.
+ */
+static void region_fill(struct quirc *q, int rcode, int from, int to,
+			span_func_t func, void *user_data)
+{
+	const struct quirc_region *region = &q->regions[rcode];
+
+	if (q->runs_valid) {
+		const int run = find_run(q, region->seed.x, region->seed.y);
+		int i;
+
+		if (!func || run < 0)
+			return;
+
+		for (i = q->runs[run].parent; i >= 0; i = q->runs[i].next) {
+			const struct quirc_run *r = &q->runs[i];
+
+			func(user_data, r->y, r->left, r->right);
+		}
+		return;
+	}
+
+	flood_fill_seed(q, region->seed.x, region->seed.y, from, to,
+			func, user_data);
+}
+
 struct polygon_score_data {
 	struct quirc_point	ref;
 
@@ -441,9 +753,8 @@ static void find_region_corners(struct quirc *q,
 
 	memcpy(&psd.ref, ref, sizeof(psd.ref));
 	psd.scores[0] = -1;
-	flood_fill_seed(q, region->seed.x, region->seed.y,
-			rcode, QUIRC_PIXEL_BLACK,
-			find_one_corner, &psd);
+	region_fill(q, rcode, rcode, QUIRC_PIXEL_BLACK,
+		    find_one_corner, &psd);
 
 	psd.ref.x = psd.corners[0].x - psd.ref.x;
 	psd.ref.y = psd.corners[0].y - psd.ref.y;
@@ -459,9 +770,8 @@ static void find_region_corners(struct quirc *q,
 	psd.scores[1] = i;
 	psd.scores[3] = -i;
 
-	flood_fill_seed(q, region->seed.x, region->seed.y,
-			QUIRC_PIXEL_BLACK, rcode,
-			find_other_corners, &psd);
+	region_fill(q, rcode, QUIRC_PIXEL_BLACK, rcode,
+		    find_other_corners, &psd);
 }
 
 static void record_capstone(struct quirc *q, int ring, int stone)
@@ -471,9 +781,13 @@ static void record_capstone(struct quirc *q, int ring, int stone)
 	struct quirc_capstone *capstone;
 	int cs_index;
 
-	if (q->num_capstones >= QUIRC_MAX_CAPSTONES)
+	capstone = grow_table(q->capstones, &q->max_capstones,
+			      q->num_capstones + 1, QUIRC_MAX_CAPSTONES,
+			      sizeof(*capstone));
+	if (!capstone)
 		return;
 
+	q->capstones = capstone;
 	cs_index = q->num_capstones;
 	capstone = &q->capstones[q->num_capstones++];
 
@@ -531,47 +845,139 @@ static void test_capstone(struct quirc *q, unsigned int x, unsigned int y,
 	record_capstone(q, ring_left, stone);
 }
 
-static void finder_scan(struct quirc *q, unsigned int y)
+static void push_candidate(struct quirc_finder_band *band,
+			   unsigned int x, unsigned int y,
+			   const unsigned int *pb)
 {
-	quirc_pixel_t *row = q->pixels + y * q->w;
-	unsigned int x;
-	int last_color = 0;
-	unsigned int run_length = 0;
+	struct quirc_finder_candidate *c;
+
+	if (band->num_candidates >= band->max_candidates) {
+		int max = band->max_candidates ? band->max_candidates * 2 : 64;
+		struct quirc_finder_candidate *grown =
+		    realloc(band->candidates, sizeof(*grown) * max);
+
+		/* Out of memory: drop the candidate, as quirc does
+		 * elsewhere when its tables are full.
+		 */
+		if (!grown)
+			return;
+
+		band->candidates = grown;
+		band->max_candidates = max;
+	}
+
+	c = &band->candidates[band->num_candidates++];
+	c->x = x;
+	c->y = y;
+	memcpy(c->pb, pb, sizeof(c->pb));
+}
+
+/* Scan a row for 1:1:3:1:1 run sequences. This only reads the binary
+ * image, which labelling never modifies, so rows can be scanned
+ * concurrently. Capstone tests, which flood fill, are deferred until all
+ * bands have been scanned.
+ *
+ * Runs are found by jumping between colour transitions in the packed
+ * row, so the cost depends on the number of runs rather than the width.
+ */
+static void finder_scan(const struct quirc *q, unsigned int y,
+			struct quirc_finder_band *band)
+{
+	const uint64_t *row = q->bits + y * q->bits_stride;
+	int run_start = 0;
+	int color;
 	unsigned int run_count = 0;
 	unsigned int pb[5];
 
+	if (!q->w)
+		return;
+
 	memset(pb, 0, sizeof(pb));
-	for (x = 0; x < q->w; x++) {
-		int color = row[x] ? 1 : 0;
-
-		if (x && color != last_color) {
-			memmove(pb, pb + 1, sizeof(pb[0]) * 4);
-			pb[4] = run_length;
-			run_length = 0;
-			run_count++;
-
-			if (!color && run_count >= 5) {
-				const int scale = 16;
-				static const unsigned int check[5] = {1, 1, 3, 1, 1};
-				unsigned int avg, err;
-				unsigned int i;
-				int ok = 1;
-
-				avg = (pb[0] + pb[1] + pb[3] + pb[4]) * scale / 4;
-				err = avg * 3 / 4;
-
-				for (i = 0; i < 5; i++)
-					if (pb[i] * scale < check[i] * avg - err ||
-					    pb[i] * scale > check[i] * avg + err)
-						ok = 0;
-
-				if (ok)
-					test_capstone(q, x, y, pb);
-			}
+	color = quirc_is_black(q, 0, y);
+
+	for (;;) {
+		const int x = next_transition(q, row, run_start, color);
+
+		if (x >= q->w)
+			break;
+
+		memmove(pb, pb + 1, sizeof(pb[0]) * 4);
+		pb[4] = x - run_start;
+		run_start = x;
+		run_count++;
+		color = !color;
+
+		if (!color && run_count >= 5) {
+			const int scale = 16;
+			static const unsigned int check[5] = {1, 1, 3, 1, 1};
+			unsigned int avg, err;
+			unsigned int i;
+			int ok = 1;
+
+			avg = (pb[0] + pb[1] + pb[3] + pb[4]) * scale / 4;
+			err = avg * 3 / 4;
+
+			for (i = 0; i < 5; i++)
+				if (pb[i] * scale < check[i] * avg - err ||
+				    pb[i] * scale > check[i] * avg + err)
+					ok = 0;
+
+			if (ok)
+				push_candidate(band, x, y, pb);
 		}
+	}
+}
 
-		run_length++;
-		last_color = color;
+static void finder_scan_band(void *arg, int index)
+{
+	struct quirc *q = (struct quirc *)arg;
+	struct quirc_finder_band *band = &q->finder_bands[index];
+	int y;
+
+	band->num_candidates = 0;
+	for (y = band->y_begin; y < band->y_end; y++)
+		finder_scan(q, y, band);
+}
+
+static void finder_scan_all(struct quirc *q)
+{
+	int num_bands = 1;
+	int i;
+
+	if (q->parallel_for) {
+		num_bands = q->h / QUIRC_FINDER_BAND_MIN_ROWS;
+		if (num_bands > QUIRC_MAX_FINDER_BANDS)
+			num_bands = QUIRC_MAX_FINDER_BANDS;
+		if (num_bands < 1)
+			num_bands = 1;
+	}
+
+	q->num_finder_bands = num_bands;
+	for (i = 0; i < num_bands; i++) {
+		struct quirc_finder_band *band = &q->finder_bands[i];
+
+		band->y_begin = (int)((long long)q->h * i / num_bands);
+		band->y_end = (int)((long long)q->h * (i + 1) / num_bands);
+	}
+
+	if (num_bands > 1)
+		q->parallel_for(q->parallel_for_data, num_bands,
+				finder_scan_band, q);
+	else
+		finder_scan_band(q, 0);
+
+	/* Merge in band (and therefore row) order, so that regions are
+	 * labelled exactly as they would be by a serial scan.
+	 */
+	for (i = 0; i < num_bands; i++) {
+		const struct quirc_finder_band *band = &q->finder_bands[i];
+		int j;
+
+		for (j = 0; j < band->num_candidates; j++) {
+			struct quirc_finder_candidate *c = &band->candidates[j];
+
+			test_capstone(q, c->x, c->y, c->pb);
+		}
 	}
 }
 
@@ -696,119 +1102,250 @@ static int read_cell(const struct quirc *q, int index, int x, int y)
 	if (p.y < 0 || p.y >= q->h || p.x < 0 || p.x >= q->w)
 		return 0;
 
-	return q->pixels[p.y * q->w + p.x] ? 1 : -1;
+	return quirc_is_black(q, p.x, p.y) ? 1 : -1;
 }
 
-static int fitness_cell(const struct quirc *q, int index, int x, int y)
+/* Map two points at once. Both lanes go through exactly the operations
+ * of perspective_map(), in the same order and precision, so the results
+ * are identical to mapping the points one at a time (checked against the
+ * scalar path on x86-64 SSE2; the NEON path relies on FP_CONTRACT OFF).
+ */
+static void perspective_map2(const quirc_float_t *c,
+			     const quirc_float_t *u, const quirc_float_t *v,
+			     int *x, int *y)
 {
-	const struct quirc_grid *qr = &q->grids[index];
-	int score = 0;
-	int u, v;
+#if defined(QUIRC_PERSPECTIVE_SSE2)
+	const __m128d one = _mm_set1_pd(1.0);
+	const __m128d vu = _mm_loadu_pd(u);
+	const __m128d vv = _mm_loadu_pd(v);
+	const __m128d den = _mm_div_pd(one,
+		_mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_set1_pd(c[6]), vu),
+				      _mm_mul_pd(_mm_set1_pd(c[7]), vv)), one));
+	const __m128d px = _mm_mul_pd(
+		_mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_set1_pd(c[0]), vu),
+				      _mm_mul_pd(_mm_set1_pd(c[1]), vv)),
+			   _mm_set1_pd(c[2])), den);
+	const __m128d py = _mm_mul_pd(
+		_mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_set1_pd(c[3]), vu),
+				      _mm_mul_pd(_mm_set1_pd(c[4]), vv)),
+			   _mm_set1_pd(c[5])), den);
+	/* cvtpd rounds with the current mode, like rint() */
+	const __m128i ix = _mm_cvtpd_epi32(px);
+	const __m128i iy = _mm_cvtpd_epi32(py);
+
+	x[0] = _mm_cvtsi128_si32(ix);
+	x[1] = _mm_cvtsi128_si32(_mm_shuffle_epi32(ix, 1));
+	y[0] = _mm_cvtsi128_si32(iy);
+	y[1] = _mm_cvtsi128_si32(_mm_shuffle_epi32(iy, 1));
+#elif defined(QUIRC_PERSPECTIVE_NEON)
+	const float64x2_t one = vdupq_n_f64(1.0);
+	const float64x2_t vu = vld1q_f64(u);
+	const float64x2_t vv = vld1q_f64(v);
+	const float64x2_t den = vdivq_f64(one,
+		vaddq_f64(vaddq_f64(vmulq_n_f64(vu, c[6]),
+				    vmulq_n_f64(vv, c[7])), one));
+	const float64x2_t px = vmulq_f64(
+		vaddq_f64(vaddq_f64(vmulq_n_f64(vu, c[0]),
+				    vmulq_n_f64(vv, c[1])),
+			  vdupq_n_f64(c[2])), den);
+	const float64x2_t py = vmulq_f64(
+		vaddq_f64(vaddq_f64(vmulq_n_f64(vu, c[3]),
+				    vmulq_n_f64(vv, c[4])),
+			  vdupq_n_f64(c[5])), den);
+	/* round to nearest, ties to even, as rint() in the default mode,
+	 * then saturate to int like the scalar (int) conversion does on
+	 * arm64: a plain narrowing would wrap a point far outside the
+	 * image back into it.
+	 */
+	const int32x2_t ix = vqmovn_s64(vcvtnq_s64_f64(px));
+	const int32x2_t iy = vqmovn_s64(vcvtnq_s64_f64(py));
 
-	for (v = 0; v < 3; v++)
-		for (u = 0; u < 3; u++) {
-			static const quirc_float_t offsets[] = {0.3, 0.5, 0.7};
-			struct quirc_point p;
+	x[0] = vget_lane_s32(ix, 0);
+	x[1] = vget_lane_s32(ix, 1);
+	y[0] = vget_lane_s32(iy, 0);
+	y[1] = vget_lane_s32(iy, 1);
+#else
+	int i;
 
-			perspective_map(qr->c, x + offsets[u],
-					       y + offsets[v], &p);
-			if (p.y < 0 || p.y >= q->h || p.x < 0 || p.x >= q->w)
-				continue;
+	for (i = 0; i < 2; i++) {
+		struct quirc_point p;
 
-			if (q->pixels[p.y * q->w + p.x])
-				score++;
-			else
-				score--;
-		}
+		perspective_map(c, u[i], v[i], &p);
+		x[i] = p.x;
+		y[i] = p.y;
+	}
+#endif
+}
 
-	return score;
+/* +1 for black, -1 for white, 0 outside the image */
+static int sample_score(const struct quirc *q, int x, int y)
+{
+	if (y < 0 || y >= q->h || x < 0 || x >= q->w)
+		return 0;
+
+	return quirc_is_black(q, x, y) ? 1 : -1;
+}
+
+/* The fitness of a perspective transform is a weighted sum over cells
+ * whose colour we know in advance. Each cell is sampled on a 3x3
+ * pattern. The cells only depend on the grid size, so they are listed
+ * once per grid and every jiggle step just maps and samples them.
+ */
+struct fitness_cell {
+	short			x;
+	short			y;
+	signed char		weight;
+};
+
+/* Timing patterns, three capstones (cell + three rings) and a full set
+ * of alignment patterns (cell + two rings) for the largest version.
+ */
+#define QUIRC_MAX_FITNESS_CELLS \
+	(2 * (QUIRC_MAX_GRID_SIZE - 14) + 3 * 49 + \
+	 (2 * (QUIRC_MAX_ALIGNMENT - 2) + \
+	  (QUIRC_MAX_ALIGNMENT - 1) * (QUIRC_MAX_ALIGNMENT - 1)) * 25)
+
+struct fitness_list {
+	int			count;
+	int			num_timing;	/* timing cells come first */
+	struct fitness_cell	cells[QUIRC_MAX_FITNESS_CELLS];
+};
+
+static void fitness_push(struct fitness_list *fl, int x, int y, int weight)
+{
+	struct fitness_cell *cell;
+
+	QUIRC_ASSERT(fl->count < QUIRC_MAX_FITNESS_CELLS);
+	cell = &fl->cells[fl->count++];
+	cell->x = x;
+	cell->y = y;
+	cell->weight = weight;
 }
 
-static int fitness_ring(const struct quirc *q, int index, int cx, int cy,
-			int radius)
+static void fitness_push_ring(struct fitness_list *fl, int cx, int cy,
+			      int radius, int weight)
 {
 	int i;
-	int score = 0;
 
 	for (i = 0; i < radius * 2; i++) {
-		score += fitness_cell(q, index, cx - radius + i, cy - radius);
-		score += fitness_cell(q, index, cx - radius, cy + radius - i);
-		score += fitness_cell(q, index, cx + radius, cy - radius + i);
-		score += fitness_cell(q, index, cx + radius - i, cy + radius);
+		fitness_push(fl, cx - radius + i, cy - radius, weight);
+		fitness_push(fl, cx - radius, cy + radius - i, weight);
+		fitness_push(fl, cx + radius, cy - radius + i, weight);
+		fitness_push(fl, cx + radius - i, cy + radius, weight);
 	}
-
-	return score;
 }
 
-static int fitness_apat(const struct quirc *q, int index, int cx, int cy)
+static void fitness_push_apat(struct fitness_list *fl, int cx, int cy)
 {
-	return fitness_cell(q, index, cx, cy) -
-		fitness_ring(q, index, cx, cy, 1) +
-		fitness_ring(q, index, cx, cy, 2);
+	fitness_push(fl, cx, cy, 1);
+	fitness_push_ring(fl, cx, cy, 1, -1);
+	fitness_push_ring(fl, cx, cy, 2, 1);
 }
 
-static int fitness_capstone(const struct quirc *q, int index, int x, int y)
+static void fitness_push_capstone(struct fitness_list *fl, int x, int y)
 {
 	x += 3;
 	y += 3;
 
-	return fitness_cell(q, index, x, y) +
-		fitness_ring(q, index, x, y, 1) -
-		fitness_ring(q, index, x, y, 2) +
-		fitness_ring(q, index, x, y, 3);
+	fitness_push(fl, x, y, 1);
+	fitness_push_ring(fl, x, y, 1, 1);
+	fitness_push_ring(fl, x, y, 2, -1);
+	fitness_push_ring(fl, x, y, 3, 1);
 }
 
-/* Compute a fitness score for the currently configured perspective
- * transform, using the features we expect to find by scanning the
- * grid.
- */
-static int fitness_all(const struct quirc *q, int index)
+/* List the features we expect to find by scanning the grid */
+static void fitness_setup(const struct quirc *q, int index,
+			  struct fitness_list *fl)
 {
 	const struct quirc_grid *qr = &q->grids[index];
 	int version = (qr->grid_size - 17) / 4;
-	const struct quirc_version_info *info = &quirc_version_db[version];
-	int score = 0;
+	const struct quirc_version_info *info;
 	int i, j;
 	int ap_count;
 
+	fl->count = 0;
+
 	/* Check the timing pattern */
 	for (i = 0; i < qr->grid_size - 14; i++) {
 		int expect = (i & 1) ? 1 : -1;
 
-		score += fitness_cell(q, index, i + 7, 6) * expect;
-		score += fitness_cell(q, index, 6, i + 7) * expect;
+		fitness_push(fl, i + 7, 6, expect);
+		fitness_push(fl, 6, i + 7, expect);
 	}
+	fl->num_timing = fl->count;
 
 	/* Check capstones */
-	score += fitness_capstone(q, index, 0, 0);
-	score += fitness_capstone(q, index, qr->grid_size - 7, 0);
-	score += fitness_capstone(q, index, 0, qr->grid_size - 7);
+	fitness_push_capstone(fl, 0, 0);
+	fitness_push_capstone(fl, qr->grid_size - 7, 0);
+	fitness_push_capstone(fl, 0, qr->grid_size - 7);
 
 	if (version < 0 || version > QUIRC_MAX_VERSION)
-		return score;
+		return;
 
 	/* Check alignment patterns */
+	info = &quirc_version_db[version];
 	ap_count = 0;
 	while ((ap_count < QUIRC_MAX_ALIGNMENT) && info->apat[ap_count])
 		ap_count++;
 
 	for (i = 1; i + 1 < ap_count; i++) {
-		score += fitness_apat(q, index, 6, info->apat[i]);
-		score += fitness_apat(q, index, info->apat[i], 6);
+		fitness_push_apat(fl, 6, info->apat[i]);
+		fitness_push_apat(fl, info->apat[i], 6);
 	}
 
 	for (i = 1; i < ap_count; i++)
 		for (j = 1; j < ap_count; j++)
-			score += fitness_apat(q, index,
-					info->apat[i], info->apat[j]);
+			fitness_push_apat(fl, info->apat[i], info->apat[j]);
+}
+
+/* Compute a fitness score for the currently configured perspective
+ * transform over the first `count' listed cells. Cells are taken two
+ * at a time, one per SIMD lane.
+ */
+static int fitness_eval(const struct quirc *q, int index,
+			const struct fitness_list *fl, int count)
+{
+	static const quirc_float_t offsets[] = {0.3, 0.5, 0.7};
+	const quirc_float_t *c = q->grids[index].c;
+	int score = 0;
+	int i;
+
+	for (i = 0; i < count; i += 2) {
+		const struct fitness_cell *a = &fl->cells[i];
+		/* Odd count: the last lane repeats the cell with no weight */
+		const struct fitness_cell *b = (i + 1 < count) ? a + 1 : a;
+		int score_a = 0;
+		int score_b = 0;
+		int u, v;
+
+		for (v = 0; v < 3; v++)
+			for (u = 0; u < 3; u++) {
+				quirc_float_t pu[2], pv[2];
+				int x[2], y[2];
+
+				pu[0] = a->x + offsets[u];
+				pv[0] = a->y + offsets[v];
+				pu[1] = b->x + offsets[u];
+				pv[1] = b->y + offsets[v];
+				perspective_map2(c, pu, pv, x, y);
+
+				score_a += sample_score(q, x[0], y[0]);
+				score_b += sample_score(q, x[1], y[1]);
+			}
+
+		score += score_a * a->weight;
+		if (b != a)
+			score += score_b * b->weight;
+	}
 
 	return score;
 }
 
-static void jiggle_perspective(struct quirc *q, int index)
+static void jiggle_perspective(struct quirc *q, int index,
+			       const struct fitness_list *fl)
 {
 	struct quirc_grid *qr = &q->grids[index];
-	int best = fitness_all(q, index);
+	int best = fitness_eval(q, index, fl, fl->count);
 	int pass;
 	quirc_float_t adjustments[8];
 	int i;
@@ -830,7 +1367,7 @@ static void jiggle_perspective(struct quirc *q, int index)
 				new = old - step;
 
 			qr->c[j] = new;
-			test = fitness_all(q, index);
+			test = fitness_eval(q, index, fl, fl->count);
 
 			if (test > best)
 				best = test;
@@ -861,8 +1398,21 @@ static void setup_qr_perspective(struct quirc *q, int index)
 	memcpy(&rect[3], &q->capstones[qr->caps[0]].corners[0],
 	       sizeof(rect[0]));
 	perspective_setup(qr->c, rect, qr->grid_size - 7, qr->grid_size - 7);
+}
 
-	jiggle_perspective(q, index);
+/* Before jiggling, the timing patterns of a real code already score
+ * above half of the maximum on our test scenes, while grids assembled
+ * from the capstones of neighbouring codes score around zero. Requiring
+ * a fifth rejects those cheaply: jiggling a large grid costs thousands
+ * of cell reads per step. Only applied with quirc_set_timing_reject(),
+ * since it has not been checked against real camera frames.
+ */
+static int timing_plausible(const struct quirc *q, int index,
+			    const struct fitness_list *fl)
+{
+	const int best = fl->num_timing * 9;
+
+	return fitness_eval(q, index, fl, fl->num_timing) * 5 >= best;
 }
 
 /* Rotate the capstone with so that corner 0 is the leftmost with respect
@@ -902,10 +1452,15 @@ static void record_qr_grid(struct quirc *q, int a, int b, int c)
 	int i;
 	int qr_index;
 	struct quirc_grid *qr;
+	struct fitness_list fitness;
 
-	if (q->num_grids >= QUIRC_MAX_GRIDS)
+	qr = grow_table(q->grids, &q->max_grids, q->num_grids + 1,
+			QUIRC_MAX_GRIDS, sizeof(*qr));
+	if (!qr)
 		return;
 
+	q->grids = qr;
+
 	/* Construct the hypotenuse line from A to C. B should be to
 	 * the left of this line.
 	 */
@@ -948,6 +1503,14 @@ static void record_qr_grid(struct quirc *q, int a, int b, int c)
 	 * transform.
 	 */
 	measure_grid_size(q, qr_index);
+
+	/* Capstones from different codes can line up well enough to be
+	 * grouped. When the implied grid isn't a valid version there is no
+	 * point fitting a perspective to it: quirc_decode() would reject it.
+	 */
+	if (qr->grid_size < 21 || qr->grid_size > QUIRC_MAX_GRID_SIZE)
+		goto fail;
+
 	/* Make an estimate based for the alignment pattern based on extending
 	 * lines from capstones A and C.
 	 */
@@ -979,16 +1542,22 @@ static void record_qr_grid(struct quirc *q, int a, int b, int c)
 			psd.scores[0] = -hd.y * qr->align.x +
 				hd.x * qr->align.y;
 
-			flood_fill_seed(q, reg->seed.x, reg->seed.y,
-					qr->align_region, QUIRC_PIXEL_BLACK,
-					NULL, NULL);
-			flood_fill_seed(q, reg->seed.x, reg->seed.y,
-					QUIRC_PIXEL_BLACK, qr->align_region,
-					find_leftmost_to_line, &psd);
+			region_fill(q, qr->align_region,
+				    qr->align_region, QUIRC_PIXEL_BLACK,
+				    NULL, NULL);
+			region_fill(q, qr->align_region,
+				    QUIRC_PIXEL_BLACK, qr->align_region,
+				    find_leftmost_to_line, &psd);
 		}
 	}
 
 	setup_qr_perspective(q, qr_index);
+
+	fitness_setup(q, qr_index, &fitness);
+	if (q->timing_reject && !timing_plausible(q, qr_index, &fitness))
+		goto fail;
+
+	jiggle_perspective(q, qr_index, &fitness);
 	return;
 
 fail:
@@ -1000,13 +1569,8 @@ fail:
 	q->num_grids--;
 }
 
-struct neighbour {
-	int		index;
-	quirc_float_t		distance;
-};
-
 struct neighbour_list {
-	struct neighbour	n[QUIRC_MAX_CAPSTONES];
+	struct quirc_neighbour	*n;
 	int			count;
 };
 
@@ -1016,9 +1580,9 @@ static void test_neighbours(struct quirc *q, int i,
 {
 	/* Test each possible grouping */
 	for (int j = 0; j < hlist->count; j++) {
-		const struct neighbour *hn = &hlist->n[j];
+		const struct quirc_neighbour *hn = &hlist->n[j];
 		for (int k = 0; k < vlist->count; k++) {
-			const struct neighbour *vn = &vlist->n[k];
+			const struct quirc_neighbour *vn = &vlist->n[k];
 			quirc_float_t squareness = fabs((quirc_float_t)1.0 - hn->distance / vn->distance);
 			if (squareness < (quirc_float_t)0.2)
 				record_qr_grid(q, hn->index, i, vn->index);
@@ -1033,7 +1597,10 @@ static void test_grouping(struct quirc *q, unsigned int i)
 	struct neighbour_list hlist;
 	struct neighbour_list vlist;
 
+	/* quirc_end() sized the scratch for every other capstone */
+	hlist.n = q->neighbours;
 	hlist.count = 0;
+	vlist.n = q->neighbours + q->num_capstones;
 	vlist.count = 0;
 
 	/* Look for potential neighbours by examining the relative gradients
@@ -1052,14 +1619,14 @@ static void test_grouping(struct quirc *q, unsigned int i)
 		v = fabs(v - (quirc_float_t)3.5);
 
 		if (u < (quirc_float_t)0.2 * v) {
-			struct neighbour *n = &hlist.n[hlist.count++];
+			struct quirc_neighbour *n = &hlist.n[hlist.count++];
 
 			n->index = j;
 			n->distance = v;
 		}
 
 		if (v < (quirc_float_t)0.2 * u) {
-			struct neighbour *n = &vlist.n[vlist.count++];
+			struct quirc_neighbour *n = &vlist.n[vlist.count++];
 
 			n->index = j;
 			n->distance = u;
@@ -1072,18 +1639,42 @@ static void test_grouping(struct quirc *q, unsigned int i)
 	test_neighbours(q, i, &hlist, &vlist);
 }
 
-static void pixels_setup(struct quirc *q, uint8_t threshold)
+static void bits_setup(struct quirc *q, uint8_t threshold)
 {
+	int x, y;
+
+	for (y = 0; y < q->h; y++) {
+		const uint8_t *source = q->image + y * q->w;
+		uint64_t *dest = q->bits + y * q->bits_stride;
+
+		for (x = 0; x < q->w; x += 64) {
+			const int n = (q->w - x < 64) ? q->w - x : 64;
+			uint64_t word = 0;
+			int i;
+
+			for (i = 0; i < n; i++)
+				word |= (uint64_t)(source[x + i] < threshold) << i;
+
+			dest[x >> 6] = word;
+		}
+	}
+}
+
+/* Expand the binary image into the label plane used by flood fill */
+static void pixels_setup(struct quirc *q)
+{
+	int x, y;
+
 	if (QUIRC_PIXEL_ALIAS_IMAGE) {
 		q->pixels = (quirc_pixel_t *)q->image;
 	}
 
-	uint8_t* source = q->image;
-	quirc_pixel_t* dest = q->pixels;
-	int length = q->w * q->h;
-	while (length--) {
-		uint8_t value = *source++;
-		*dest++ = (value < threshold) ? QUIRC_PIXEL_BLACK : QUIRC_PIXEL_WHITE;
+	for (y = 0; y < q->h; y++) {
+		quirc_pixel_t *dest = q->pixels + y * q->w;
+
+		for (x = 0; x < q->w; x++)
+			dest[x] = quirc_is_black(q, x, y) ?
+				QUIRC_PIXEL_BLACK : QUIRC_PIXEL_WHITE;
 	}
 }
 
@@ -1092,6 +1683,8 @@ uint8_t *quirc_begin(struct quirc *q, int *w, int *h)
 	q->num_regions = QUIRC_PIXEL_REGION;
 	q->num_capstones = 0;
 	q->num_grids = 0;
+	q->runs_valid = 0;
+	q->regions_exhausted = 0;
 
 	if (w)
 		*w = q->w;
@@ -1103,14 +1696,31 @@ uint8_t *quirc_begin(struct quirc *q, int *w, int *h)
 
 void quirc_end(struct quirc *q)
 {
+	struct quirc_neighbour *neighbours;
 	int i;
 
 	uint8_t threshold = otsu(q);
-	pixels_setup(q, threshold);
+	bits_setup(q, threshold);
 
-	for (i = 0; i < q->h; i++)
-		finder_scan(q, i);
+	/* Fall back to flood fill if the run table can't be allocated */
+	if (q->labeler == QUIRC_LABELER_UNION_FIND)
+		q->runs_valid = (label_runs(q) == 0);
+
+	/* Flood fill labels regions in place, so it needs a full label
+	 * plane. The union-find labeller works from the bits alone.
+	 */
+	if (!q->runs_valid)
+		pixels_setup(q);
+
+	finder_scan_all(q);
+
+	neighbours = grow_table(q->neighbours, &q->max_neighbours,
+				q->num_capstones * 2, QUIRC_MAX_CAPSTONES * 2,
+				sizeof(*neighbours));
+	if (!neighbours)
+		return;
 
+	q->neighbours = neighbours;
 	for (i = 0; i < q->num_capstones; i++)
 		test_grouping(q, i);
 }
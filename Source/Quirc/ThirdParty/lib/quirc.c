@@ -41,14 +41,47 @@ void quirc_destroy(struct quirc *q)
 	   same size, so we need to be careful here to avoid a double free */
 	if (!QUIRC_PIXEL_ALIAS_IMAGE)
 		free(q->pixels);
+	free(q->bits);
 	free(q->flood_fill_vars);
+	for (int i = 0; i < QUIRC_MAX_FINDER_BANDS; i++)
+		free(q->finder_bands[i].candidates);
+	free(q->runs);
+	free(q->row_runs);
+	free(q->regions);
+	free(q->capstones);
+	free(q->grids);
+	free(q->neighbours);
 	free(q);
 }
 
+void quirc_set_parallel_for(struct quirc *q, quirc_parallel_for_t pfor,
+			    void *user_data)
+{
+	q->parallel_for = pfor;
+	q->parallel_for_data = user_data;
+}
+
+void quirc_set_labeler(struct quirc *q, quirc_labeler_t labeler)
+{
+	q->labeler = labeler;
+}
+
+int quirc_regions_exhausted(const struct quirc *q)
+{
+	return q->regions_exhausted;
+}
+
+void quirc_set_timing_reject(struct quirc *q, int enable)
+{
+	q->timing_reject = enable;
+}
+
 int quirc_resize(struct quirc *q, int w, int h)
 {
 	uint8_t		*image  = NULL;
 	quirc_pixel_t	*pixels = NULL;
+	uint64_t	*bits = NULL;
+	int		bits_stride;
 	size_t num_vars;
 	size_t vars_byte_size;
 	struct quirc_flood_fill_vars *vars = NULL;
@@ -90,6 +123,13 @@ int quirc_resize(struct quirc *q, int w, int h)
 			goto fail;
 	}
 
+	/* alloc the 1 bpp binarized image, one 64-bit word aligned row per
+	 * image row */
+	bits_stride = (w + 63) / 64;
+	bits = calloc((size_t)bits_stride * h, sizeof(*bits));
+	if (!bits)
+		goto fail;
+
 	/*
 	 * alloc the work area for the flood filling logic.
 	 *
@@ -126,6 +166,9 @@ int quirc_resize(struct quirc *q, int w, int h)
 		free(q->pixels);
 		q->pixels = pixels;
 	}
+	free(q->bits);
+	q->bits = bits;
+	q->bits_stride = bits_stride;
 	free(q->flood_fill_vars);
 	q->flood_fill_vars = vars;
 	q->num_flood_fill_vars = num_vars;
@@ -135,6 +178,7 @@ int quirc_resize(struct quirc *q, int w, int h)
 fail:
 	free(image);
 	free(pixels);
+	free(bits);
 	free(vars);
 
 	return -1;
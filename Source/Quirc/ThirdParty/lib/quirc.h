@@ -19,6 +19,23 @@
 
 #include <stdint.h>
 
+/* Visibility of the API when quirc lives in a shared library used by
+ * other modules (Unreal modular builds, see Quirc.Build.cs).
+ */
+#if defined(QUIRC_SHARED_LIBRARY)
+#if defined(_WIN32)
+#if defined(QUIRC_BUILDING_LIBRARY)
+#define QUIRC_EXPORT __declspec(dllexport)
+#else
+#define QUIRC_EXPORT __declspec(dllimport)
+#endif
+#else
+#define QUIRC_EXPORT __attribute__((visibility("default")))
+#endif
+#else
+#define QUIRC_EXPORT
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -26,15 +43,15 @@ extern "C" {
 struct quirc;
 
 /* Obtain the library version string. */
-const char *quirc_version(void);
+QUIRC_EXPORT const char *quirc_version(void);
 
 /* Construct a new QR-code recognizer. This function will return NULL
  * if sufficient memory could not be allocated.
  */
-struct quirc *quirc_new(void);
+QUIRC_EXPORT struct quirc *quirc_new(void);
 
 /* Destroy a QR-code recognizer. */
-void quirc_destroy(struct quirc *q);
+QUIRC_EXPORT void quirc_destroy(struct quirc *q);
 
 /* Resize the QR-code recognizer. The size of an image must be
  * specified before codes can be analyzed.
@@ -42,7 +59,7 @@ void quirc_destroy(struct quirc *q);
  * This function returns 0 on success, or -1 if sufficient memory could
  * not be allocated.
  */
-int quirc_resize(struct quirc *q, int w, int h);
+QUIRC_EXPORT int quirc_resize(struct quirc *q, int w, int h);
 
 /* These functions are used to process images for QR-code recognition.
  * quirc_begin() must first be called to obtain access to a buffer into
@@ -53,8 +70,58 @@ int quirc_resize(struct quirc *q, int w, int h);
  * the image for QR-code recognition. The locations and content of each
  * code may be obtained using accessor functions described below.
  */
-uint8_t *quirc_begin(struct quirc *q, int *w, int *h);
-void quirc_end(struct quirc *q);
+QUIRC_EXPORT uint8_t *quirc_begin(struct quirc *q, int *w, int *h);
+QUIRC_EXPORT void quirc_end(struct quirc *q);
+
+/* Optional parallel execution of the finder-pattern row scan performed
+ * by quirc_end(). The image rows are split into bands and the supplied
+ * callback must invoke func(arg, i) exactly once for every i in
+ * [0, count), possibly concurrently, returning only after every call has
+ * completed. Candidates found in each band are merged in row order
+ * afterwards, so results are identical to the serial scan.
+ *
+ * Passing NULL as the callback restores the serial scan.
+ */
+typedef void (*quirc_parallel_func_t)(void *arg, int index);
+typedef void (*quirc_parallel_for_t)(void *user_data, int count,
+				     quirc_parallel_func_t func, void *arg);
+
+QUIRC_EXPORT void quirc_set_parallel_for(struct quirc *q, quirc_parallel_for_t pfor,
+			    void *user_data);
+
+/* Region labelling strategy used by quirc_end().
+ *
+ * QUIRC_LABELER_FLOOD_FILL labels regions lazily with a span flood fill
+ * seeded from each finder candidate. It is cheap on sparse scenes but
+ * its cost grows with the area of every region it touches, and since
+ * labels live in the pixel buffer it gives up after QUIRC_MAX_REGIONS
+ * regions, which textured backgrounds reach on large frames.
+ *
+ * QUIRC_LABELER_UNION_FIND labels the whole binarized image in a single
+ * run-length union-find pass, so area queries and region walks cost the
+ * same regardless of scene content, and the pixel buffer is never
+ * rewritten. Region, capstone and grid tables grow as needed.
+ */
+typedef enum {
+	QUIRC_LABELER_FLOOD_FILL = 0,
+	QUIRC_LABELER_UNION_FIND
+} quirc_labeler_t;
+
+QUIRC_EXPORT void quirc_set_labeler(struct quirc *q, quirc_labeler_t labeler);
+
+/* Non-zero if the last quirc_end() ran with flood fill labelling and
+ * refused a region because QUIRC_MAX_REGIONS was reached. Some finder
+ * patterns may then have been missed; running the same image again
+ * with QUIRC_LABELER_UNION_FIND recovers them.
+ */
+QUIRC_EXPORT int quirc_regions_exhausted(const struct quirc *q);
+
+/* Reject a grid before refining its perspective when its timing
+ * patterns score below a fifth of the maximum. Grids assembled from the
+ * capstones of neighbouring codes are dropped cheaply, but so may be a
+ * real code under heavy blur or glare. Disabled by default.
+ */
+QUIRC_EXPORT void quirc_set_timing_reject(struct quirc *q, int enable);
 
 /* This structure describes a location in the input image buffer. */
 struct quirc_point {
@@ -75,7 +142,7 @@ typedef enum {
 } quirc_decode_error_t;
 
 /* Return a string error message for an error code. */
-const char *quirc_strerror(quirc_decode_error_t err);
+QUIRC_EXPORT const char *quirc_strerror(quirc_decode_error_t err);
 
 /* Limits on the maximum size of QR-codes and their content. */
 #define QUIRC_MAX_VERSION	40
@@ -158,18 +225,18 @@ struct quirc_data {
 /* Return the number of QR-codes identified in the last processed
  * image.
  */
-int quirc_count(const struct quirc *q);
+QUIRC_EXPORT int quirc_count(const struct quirc *q);
 
 /* Extract the QR-code specified by the given index. */
-void quirc_extract(const struct quirc *q, int index,
+QUIRC_EXPORT void quirc_extract(const struct quirc *q, int index,
 		   struct quirc_code *code);
 
 /* Decode a QR-code, returning the payload data. */
-quirc_decode_error_t quirc_decode(const struct quirc_code *code,
+QUIRC_EXPORT quirc_decode_error_t quirc_decode(const struct quirc_code *code,
 				  struct quirc_data *data);
 
 /* Flip a QR-code according to optional mirror feature of ISO 18004:2015 */
-void quirc_flip(struct quirc_code *code);
+QUIRC_EXPORT void quirc_flip(struct quirc_code *code);
 
 #ifdef __cplusplus
 }
@@ -28,6 +28,11 @@
 #define QUIRC_PIXEL_BLACK	1
 #define QUIRC_PIXEL_REGION	2
 
+/* QUIRC_MAX_REGIONS bounds flood fill labelling, whose region codes are
+ * stored in the pixel plane. The union-find labeller keeps region codes
+ * in its run table, so it is only bounded by memory. The region,
+ * capstone and grid tables start at these sizes and grow on demand.
+ */
 #ifndef QUIRC_MAX_REGIONS
 #define QUIRC_MAX_REGIONS	254
 #endif
@@ -36,6 +41,10 @@
 
 #define QUIRC_PERSPECTIVE_PARAMS	8
 
+/* Row bands used by the (optionally parallel) finder-pattern scan */
+#define QUIRC_MAX_FINDER_BANDS		16
+#define QUIRC_FINDER_BAND_MIN_ROWS	64
+
 #if QUIRC_MAX_REGIONS < UINT8_MAX
 #define QUIRC_PIXEL_ALIAS_IMAGE	1
 typedef uint8_t quirc_pixel_t;
@@ -60,6 +69,11 @@ typedef QUIRC_FLOAT_TYPE quirc_float_t;
 typedef double quirc_float_t;
 #endif
 
+struct quirc_neighbour {
+	int			index;
+	quirc_float_t		distance;
+};
+
 struct quirc_region {
 	struct quirc_point	seed;
 	int			count;
@@ -93,6 +107,44 @@ struct quirc_grid {
 	quirc_float_t		c[QUIRC_PERSPECTIVE_PARAMS];
 };
 
+/* A 1:1:3:1:1 run sequence found by the row scan, ending at x */
+struct quirc_finder_candidate {
+	int			x;
+	int			y;
+	unsigned int		pb[5];
+};
+
+/* Band-local candidate list. Each band is scanned independently and
+ * may be processed by a different thread.
+ */
+struct quirc_finder_band {
+	int			y_begin;
+	int			y_end;
+
+	int			num_candidates;
+	int			max_candidates;
+	struct quirc_finder_candidate *candidates;
+};
+
+/* A horizontal run of black pixels, as produced by the union-find
+ * labeller. Runs are stored in raster order; the root of a component is
+ * always its first run, and links every run of the component through
+ * next.
+ */
+struct quirc_run {
+	int			y;
+	int			left;
+	int			right;
+
+	int			parent;
+	int			next;
+
+	/* Only meaningful on component roots */
+	int			tail;
+	int			count;
+	int			region;
+};
+
 struct quirc_flood_fill_vars {
 	int y;
 	int right;
@@ -106,19 +158,72 @@ struct quirc {
 	int			w;
 	int			h;
 
+	/* Binarized image, 1 bit per pixel (set = black), LSB first.
+	 * Finder scanning, run labelling and grid sampling only read this
+	 * plane; q->pixels is only filled when flood fill labelling needs
+	 * it.
+	 */
+	uint64_t		*bits;
+	int			bits_stride;	/* in words */
+
 	int			num_regions;
-	struct quirc_region	regions[QUIRC_MAX_REGIONS];
+	int			max_regions;
+	struct quirc_region	*regions;
 
 	int			num_capstones;
-	struct quirc_capstone	capstones[QUIRC_MAX_CAPSTONES];
+	int			max_capstones;
+	struct quirc_capstone	*capstones;
 
 	int			num_grids;
-	struct quirc_grid	grids[QUIRC_MAX_GRIDS];
+	int			max_grids;
+	struct quirc_grid	*grids;
+
+	/* Grouping scratch: two lists of up to num_capstones entries */
+	int			max_neighbours;
+	struct quirc_neighbour	*neighbours;
 
 	size_t      		num_flood_fill_vars;
 	struct quirc_flood_fill_vars *flood_fill_vars;
+
+	int			num_finder_bands;
+	struct quirc_finder_band finder_bands[QUIRC_MAX_FINDER_BANDS];
+
+	quirc_parallel_for_t	parallel_for;
+	void			*parallel_for_data;
+
+	quirc_labeler_t		labeler;
+	int			timing_reject;
+	int			regions_exhausted;
+
+	/* Union-find labelling state. When runs_valid is set, regions are
+	 * resolved through the run table instead of the pixel buffer.
+	 */
+	int			runs_valid;
+	int			num_runs;
+	int			max_runs;
+	struct quirc_run	*runs;
+	int			max_row_runs;
+	int			*row_runs;	/* h + 1 run offsets */
 };
 
+static inline int quirc_is_black(const struct quirc *q, int x, int y)
+{
+	return (int)((q->bits[y * q->bits_stride + (x >> 6)] >> (x & 63)) & 1);
+}
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+static inline int quirc_ctz64(uint64_t v)
+{
+	unsigned long i;
+
+	_BitScanForward64(&i, v);
+	return (int)i;
+}
+#else
+#define quirc_ctz64(v)	__builtin_ctzll(v)
+#endif
+
 /************************************************************************
  * QR-code version information database
  */
@@ -138,6 +243,6 @@ struct quirc_version_info {
 	struct quirc_rs_params          ecc[4];
 };
 
-extern const struct quirc_version_info quirc_version_db[QUIRC_MAX_VERSION + 1];
+extern QUIRC_EXPORT const struct quirc_version_info quirc_version_db[QUIRC_MAX_VERSION + 1];
 
 #endif
@@ -0,0 +1,782 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+#include "QuircBenchmarkCommandlet.h"
+#include "QuircBenchmarkEncoder.h"
+#include "QuircBenchmarkScenes.h"
+#include "QuircReader.h"
+#include "HAL/MemoryBase.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include <atomic>
+
+extern "C" {
+	#include "quirc.h"
+}
+
+DEFINE_LOG_CATEGORY_STATIC(LogQuircBenchmark, Log, All);
+
+namespace QuircBenchmark
+{
+	// -TimingReject: quirc_set_timing_reject on every decoder, to compare recall with and without it.
+	static bool bTimingReject = false;
+
+	struct FResult
+	{
+		FString Scenario;
+		FString Variant;
+		int32 Width = 0;
+		int32 Height = 0;
+		int32 Frames = 0;
+		double NsPerFrame = 0.0;
+		int32 Detected = 0;
+		int32 Expected = 0;				// codes present; recall is only reported when > 0
+		double AllocsPerFrame = -1.0;	// engine heap allocations; < 0 when not measured
+
+		FString ToJson() const
+		{
+			FString Json = FString::Printf(TEXT("{\"scenario\":\"%s\",\"variant\":\"%s\",\"width\":%d,\"height\":%d,\"frames\":%d,\"ns_per_frame\":%.0f,\"detected\":%d"),
+				*Scenario, *Variant, Width, Height, Frames, NsPerFrame, Detected);
+
+			if (Expected > 0)
+			{
+				Json += FString::Printf(TEXT(",\"expected\":%d,\"recall\":%.4f"), Expected, static_cast<double>(Detected) / Expected);
+			}
+			if (AllocsPerFrame >= 0.0)
+			{
+				Json += FString::Printf(TEXT(",\"allocs_per_frame\":%.2f"), AllocsPerFrame);
+			}
+
+			return Json + TEXT("}");
+		}
+	};
+
+	// Forwards to the engine allocator and counts Malloc/Realloc calls while installed.
+	// quirc itself allocates through the C runtime, which this does not see.
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			NumAllocs.fetch_add(1, std::memory_order_relaxed);
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			NumAllocs.fetch_add(1, std::memory_order_relaxed);
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			Inner->Free(Original);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return Inner->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return Inner->IsInternallyThreadSafe();
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return TEXT("QuircBenchmarkCounting");
+		}
+
+		uint64 GetNumAllocs() const
+		{
+			return NumAllocs.load(std::memory_order_relaxed);
+		}
+
+	private:
+		FMalloc* Inner;
+		std::atomic<uint64> NumAllocs{0};
+	};
+
+	// Installs a counting proxy over GMalloc for its lifetime. Memory allocated
+	// through the proxy is freed by the same inner allocator either way, and the
+	// proxy itself is never destroyed in case another thread is still inside it.
+	class FScopedAllocCounter
+	{
+	public:
+		FScopedAllocCounter()
+			: Previous(GMalloc)
+		{
+			static FCountingMalloc* Counter = new FCountingMalloc(GMalloc);
+			Proxy = Counter;
+			Start = Proxy->GetNumAllocs();
+			GMalloc = Proxy;
+		}
+
+		~FScopedAllocCounter()
+		{
+			GMalloc = Previous;
+		}
+
+		uint64 GetNumAllocs() const
+		{
+			return Proxy->GetNumAllocs() - Start;
+		}
+
+	private:
+		FMalloc* Previous;
+		FCountingMalloc* Proxy;
+		uint64 Start;
+	};
+
+	// Dense textures that produce many large regions and finder-like runs.
+	enum class ETexture : uint8
+	{
+		Foliage,	// random blobs, lots of medium sized regions
+		Maze,		// grid with gaps, one huge connected region
+		Text		// rows of short glyph-like bars
+	};
+
+	static const TCHAR* TextureName(ETexture Texture)
+	{
+		switch (Texture)
+		{
+		case ETexture::Foliage: return TEXT("Foliage");
+		case ETexture::Maze:    return TEXT("Maze");
+		default:                return TEXT("Text");
+		}
+	}
+
+	static void FillRect(TArray<uint8>& Img, int32 W, int32 H, int32 X0, int32 Y0, int32 RW, int32 RH, uint8 Value)
+	{
+		const int32 X1 = FMath::Min(W, X0 + RW);
+		const int32 Y1 = FMath::Min(H, Y0 + RH);
+		for (int32 Y = FMath::Max(0, Y0); Y < Y1; ++Y)
+		{
+			for (int32 X = FMath::Max(0, X0); X < X1; ++X)
+			{
+				Img[Y * W + X] = Value;
+			}
+		}
+	}
+
+	static void MakeTexture(ETexture Texture, int32 W, int32 H, int32 Seed, TArray<uint8>& Img)
+	{
+		FRandomStream Rng(Seed);
+		Img.Init(230, W * H);
+
+		switch (Texture)
+		{
+		case ETexture::Foliage:
+			for (int32 i = 0, N = (W * H) / 12; i < N; ++i)
+			{
+				FillRect(Img, W, H, Rng.RandHelper(W), Rng.RandHelper(H), Rng.RandRange(2, 6), Rng.RandRange(2, 6), 20);
+			}
+			break;
+
+		case ETexture::Maze:
+			for (int32 Y = 0; Y < H; Y += 6)
+			{
+				for (int32 X = 0; X < W; X += 6)
+				{
+					if (Rng.FRand() < 0.8f) { FillRect(Img, W, H, X, Y, 6, 2, 20); }
+					if (Rng.FRand() < 0.8f) { FillRect(Img, W, H, X, Y, 2, 6, 20); }
+				}
+			}
+			break;
+
+		case ETexture::Text:
+			for (int32 Y = 4; Y + 8 < H; Y += 12)
+			{
+				for (int32 X = 4; X < W;)
+				{
+					const int32 BarW = Rng.RandRange(1, 4);
+					FillRect(Img, W, H, X, Y, BarW, 8, 20);
+					X += BarW + Rng.RandRange(1, 4);
+				}
+			}
+			break;
+		}
+	}
+
+	// FloodFillRetry is what FQuircReader does: flood fill, and union-find again only
+	// when flood fill ran out of regions.
+	enum class ELabeling : uint8 { FloodFill, UnionFind, FloodFillRetry };
+
+	static const TCHAR* LabelingName(ELabeling Labeling)
+	{
+		switch (Labeling)
+		{
+		case ELabeling::FloodFill:      return TEXT("FloodFill");
+		case ELabeling::UnionFind:      return TEXT("UnionFind");
+		case ELabeling::FloodFillRetry: return TEXT("FloodFillRetry");
+		}
+		return TEXT("Unknown");
+	}
+
+	// Times quirc_end on the same frame. quirc_begin/memcpy are included since
+	// every real frame pays for them.
+	static FResult TimeQuirc(quirc* Q, ELabeling Labeling, const TArray<uint8>& Img, int32 W, int32 H, int32 Frames)
+	{
+		FResult R;
+		R.Width = W;
+		R.Height = H;
+		R.Frames = Frames;
+
+		const quirc_labeler_t First = (Labeling == ELabeling::UnionFind) ? QUIRC_LABELER_UNION_FIND : QUIRC_LABELER_FLOOD_FILL;
+
+		const uint64 T0 = FPlatformTime::Cycles64();
+		for (int32 F = 0; F < Frames; ++F)
+		{
+			quirc_set_labeler(Q, First);
+			FMemory::Memcpy(quirc_begin(Q, nullptr, nullptr), Img.GetData(), W * H);
+			quirc_end(Q);
+
+			if (Labeling == ELabeling::FloodFillRetry && quirc_regions_exhausted(Q))
+			{
+				quirc_set_labeler(Q, QUIRC_LABELER_UNION_FIND);
+				FMemory::Memcpy(quirc_begin(Q, nullptr, nullptr), Img.GetData(), W * H);
+				quirc_end(Q);
+			}
+		}
+		const uint64 T1 = FPlatformTime::Cycles64();
+
+		R.NsPerFrame = FPlatformTime::ToSeconds64(T1 - T0) * 1e9 / FMath::Max(1, Frames);
+		R.Detected = quirc_count(Q);
+		return R;
+	}
+
+	static void RunLabeling(int32 W, int32 H, int32 Frames, TArray<FResult>& Out)
+	{
+		static const ELabeling Labelings[] = { ELabeling::FloodFill, ELabeling::UnionFind, ELabeling::FloodFillRetry };
+
+		for (ETexture Texture : { ETexture::Foliage, ETexture::Maze, ETexture::Text })
+		{
+			TArray<uint8> Img;
+			MakeTexture(Texture, W, H, /*Seed*/ 1234, Img);
+
+			for (ELabeling Labeling : Labelings)
+			{
+				quirc* Q = quirc_new();
+				if (!Q || quirc_resize(Q, W, H) != 0)
+				{
+					quirc_destroy(Q);
+					continue;
+				}
+				quirc_set_timing_reject(Q, bTimingReject ? 1 : 0);
+
+				FResult R = TimeQuirc(Q, Labeling, Img, W, H, Frames);
+				R.Scenario = FString::Printf(TEXT("Labeling/%s"), TextureName(Texture));
+				R.Variant = LabelingName(Labeling);
+				Out.Add(MoveTemp(R));
+
+				quirc_destroy(Q);
+			}
+		}
+	}
+
+	// Codes pasted over a dense texture, which is what fills quirc's region table on
+	// large frames. Compares the flood fill labeller (8-bit pixel labels, at most
+	// QUIRC_MAX_REGIONS regions) with union-find (run labels, tables grow as needed)
+	// and with flood fill that falls back to union-find when it runs out.
+	// Detected counts distinct payloads decoded from the last frame.
+	static void RunCapacity(int32 W, int32 H, int32 Frames, TArray<FResult>& Out)
+	{
+		static const ELabeling Labelings[] = { ELabeling::FloodFill, ELabeling::UnionFind, ELabeling::FloodFillRetry };
+		const int32 Version = 4;
+		const int32 Cols = 3;
+		const int32 Rows = 2;
+
+		for (ETexture Texture : { ETexture::Foliage, ETexture::Text })
+		{
+			TArray<uint8> Img;
+			MakeTexture(Texture, W, H, /*Seed*/ 1234, Img);
+
+			TArray<TArray<uint8>> Payloads;
+			for (int32 i = 0; i < Cols * Rows; ++i)
+			{
+				const FString Text = FString::Printf(TEXT("CAP%d"), i);
+				const FTCHARToUTF8 Utf8(*Text);
+				TArray<uint8>& Payload = Payloads.AddDefaulted_GetRef();
+				Payload.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+
+				TArray<uint8> Modules;
+				int32 Size = 0;
+				if (!EncodeQR(Payload, Version, /*QUIRC_ECC_LEVEL_M*/ 0, i % 8, Modules, Size))
+				{
+					Payloads.Pop();
+					continue;
+				}
+
+				// Each code with its quiet zone takes about a quarter of the frame height.
+				const int32 Scale = FMath::Max(2, H / (4 * (Size + 8)));
+				const int32 Span = (Size + 8) * Scale;
+				const int32 OX = (W / Cols) * (i % Cols) + (W / Cols - Span) / 2;
+				const int32 OY = (H / Rows) * (i / Cols) + (H / Rows - Span) / 2;
+				BlitQR(Img, W, H, Modules, Size, Scale, OX, OY);
+			}
+
+			for (ELabeling Labeling : Labelings)
+			{
+				quirc* Q = quirc_new();
+				if (!Q || quirc_resize(Q, W, H) != 0)
+				{
+					quirc_destroy(Q);
+					continue;
+				}
+				quirc_set_timing_reject(Q, bTimingReject ? 1 : 0);
+
+				FResult R = TimeQuirc(Q, Labeling, Img, W, H, Frames);
+				R.Scenario = FString::Printf(TEXT("Capacity/%s"), TextureName(Texture));
+				R.Variant = LabelingName(Labeling);
+				R.Detected = 0;
+				R.Expected = Payloads.Num();
+
+				TArray<bool> Found;
+				Found.Init(false, Payloads.Num());
+				for (int32 i = 0, Count = quirc_count(Q); i < Count; ++i)
+				{
+					quirc_code Code;
+					quirc_data Data;
+					quirc_extract(Q, i, &Code);
+					if (quirc_decode(&Code, &Data) != QUIRC_SUCCESS)
+					{
+						continue;
+					}
+
+					for (int32 j = 0; j < Payloads.Num(); ++j)
+					{
+						if (!Found[j] && Data.payload_len == Payloads[j].Num() &&
+						    FMemory::Memcmp(Data.payload, Payloads[j].GetData(), Payloads[j].Num()) == 0)
+						{
+							Found[j] = true;
+							++R.Detected;
+						}
+					}
+				}
+
+				Out.Add(MoveTemp(R));
+				quirc_destroy(Q);
+			}
+		}
+	}
+
+	// quirc_end alone on keystoned, rotated codes, versions 1 to 40 repeated Passes
+	// times. Grid refinement (perspective fitting) is most of the cost once a code is
+	// found, so this tracks it. Detected counts codes that decode.
+	static void RunPerspective(int32 W, int32 H, int32 Passes, TArray<FResult>& Out)
+	{
+		quirc* Q = quirc_new();
+		if (!Q)
+		{
+			return;
+		}
+		if (quirc_resize(Q, W, H) != 0)
+		{
+			quirc_destroy(Q);
+			return;
+		}
+		quirc_set_labeler(Q, QUIRC_LABELER_UNION_FIND);
+		quirc_set_timing_reject(Q, bTimingReject ? 1 : 0);
+
+		FResult R;
+		R.Scenario = TEXT("Perspective");
+		R.Variant = TEXT("QuircEnd");
+		R.Width = W;
+		R.Height = H;
+
+		double Seconds = 0.0;
+
+		for (int32 Pass = 0; Pass < Passes; ++Pass)
+		{
+			FRandomStream Rng(/*Seed*/ 1234 + Pass);
+
+			for (int32 Version = 1; Version <= 40; ++Version)
+			{
+				FScene Scene;
+				if (!MakeScene(ESceneKind::Perspective, Version, W, H, Rng, Scene))
+				{
+					continue;
+				}
+
+				const uint64 T0 = FPlatformTime::Cycles64();
+				FMemory::Memcpy(quirc_begin(Q, nullptr, nullptr), Scene.Luma.GetData(), W * H);
+				quirc_end(Q);
+				const uint64 T1 = FPlatformTime::Cycles64();
+
+				Seconds += FPlatformTime::ToSeconds64(T1 - T0);
+				++R.Frames;
+				R.Expected += Scene.Payloads.Num();
+
+				for (int32 i = 0, Count = quirc_count(Q); i < Count; ++i)
+				{
+					quirc_code Code;
+					quirc_data Data;
+					quirc_extract(Q, i, &Code);
+					if (quirc_decode(&Code, &Data) == QUIRC_SUCCESS)
+					{
+						++R.Detected;
+					}
+				}
+			}
+		}
+
+		R.NsPerFrame = Seconds * 1e9 / FMath::Max(1, R.Frames);
+		Out.Add(MoveTemp(R));
+		quirc_destroy(Q);
+	}
+
+	// quirc_decode on grids built straight from the encoder, versions 1 to 40 over
+	// all four ECC levels. Damaged variants flip random codeword cells, up to the
+	// given fraction of what the ECC blocks can correct.
+	static void RunDecode(int32 Iterations, TArray<FResult>& Out)
+	{
+		static const int32 DamagePercents[] = { 0, 25, 50 };
+
+		FRandomStream Rng(/*Seed*/ 1234);
+
+		for (int32 Version = 1; Version <= 40; ++Version)
+		{
+			for (int32 DamagePercent : DamagePercents)
+			{
+				FResult R;
+				R.Scenario = FString::Printf(TEXT("Decode/V%d"), Version);
+				R.Variant = DamagePercent ? FString::Printf(TEXT("Damaged%d"), DamagePercent) : FString(TEXT("Clean"));
+				R.Frames = Iterations;
+
+				double Seconds = 0.0;
+				int32 NumDecodes = 0;
+
+				for (int32 EccLevel = 0; EccLevel < 4; ++EccLevel)
+				{
+					// Short enough to fit version 1-H.
+					const FString Text = FString::Printf(TEXT("V%dE%d"), Version, EccLevel);
+					const FTCHARToUTF8 Utf8(*Text);
+					TArray<uint8> Payload;
+					Payload.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+
+					TArray<uint8> Modules;
+					TArray<int32> DataCells;
+					int32 Size = 0;
+					if (!EncodeQR(Payload, Version, EccLevel, (Version + EccLevel) % 8, Modules, Size, &DataCells))
+					{
+						continue;
+					}
+
+					const int32 NumFlips = CorrectableCodewords(Version, EccLevel) * DamagePercent / 100;
+					for (int32 i = 0; i < NumFlips && DataCells.Num() > 0; ++i)
+					{
+						Modules[DataCells[Rng.RandHelper(DataCells.Num())]] ^= 1;
+					}
+
+					quirc_code Code;
+					FMemory::Memzero(&Code, sizeof(Code));
+					Code.size = Size;
+					for (int32 i = 0; i < Size * Size; ++i)
+					{
+						if (Modules[i])
+						{
+							Code.cell_bitmap[i >> 3] |= 1 << (i & 7);
+						}
+					}
+					R.Width = R.Height = Size;
+
+					quirc_data Data;
+					quirc_decode_error_t Err = QUIRC_SUCCESS;
+
+					const uint64 T0 = FPlatformTime::Cycles64();
+					for (int32 It = 0; It < Iterations; ++It)
+					{
+						Err = quirc_decode(&Code, &Data);
+					}
+					const uint64 T1 = FPlatformTime::Cycles64();
+
+					Seconds += FPlatformTime::ToSeconds64(T1 - T0);
+					NumDecodes += Iterations;
+
+					if (Err == QUIRC_SUCCESS && Data.payload_len == Payload.Num() &&
+					    FMemory::Memcmp(Data.payload, Payload.GetData(), Payload.Num()) == 0)
+					{
+						++R.Detected;
+					}
+				}
+
+				R.NsPerFrame = Seconds * 1e9 / FMath::Max(1, NumDecodes);
+				Out.Add(MoveTemp(R));
+			}
+		}
+	}
+
+	// Several streams at once: the same set of frames decoded one DecodeFromLuma
+	// call after another, then as one DecodeBatch. ns is per image.
+	static void RunBatch(int32 W, int32 H, int32 Iterations, TArray<FResult>& Out)
+	{
+		static const int32 BatchSizes[] = { 1, 2, 4, 8 };
+
+		FRandomStream Rng(/*Seed*/ 1234);
+		TArray<FScene> Scenes;
+		for (int32 i = 0; i < 8; ++i)
+		{
+			FScene& Scene = Scenes.AddDefaulted_GetRef();
+			if (!MakeScene(i & 1 ? ESceneKind::MultiCode : ESceneKind::Perspective, 2 + i, W, H, Rng, Scene))
+			{
+				Scenes.Pop();
+			}
+		}
+
+		for (int32 BatchSize : BatchSizes)
+		{
+			BatchSize = FMath::Min(BatchSize, Scenes.Num());
+
+			TArray<FQuircLumaImage> Images;
+			for (int32 i = 0; i < BatchSize; ++i)
+			{
+				FQuircLumaImage& Image = Images.AddDefaulted_GetRef();
+				Image.Luma = Scenes[i].Luma.GetData();
+				Image.Width = W;
+				Image.Height = H;
+				Image.Stride = W;
+				Image.SourceId = i;
+			}
+
+			FResult Serial;
+			Serial.Scenario = FString::Printf(TEXT("Batch/%d"), BatchSize);
+			Serial.Variant = TEXT("Serial");
+			Serial.Width = W;
+			Serial.Height = H;
+			Serial.Frames = Iterations * BatchSize;
+
+			FResult Batch = Serial;
+			Batch.Variant = TEXT("DecodeBatch");
+
+			// Warm the per-thread decoders so neither variant pays for the first resize.
+			TArray<FQuircBatchResult> Results;
+			FQuircReader::DecodeBatch(Images, Results);
+
+			FQuircReader::ResetDecodeCache();
+			uint64 T0 = FPlatformTime::Cycles64();
+			for (int32 It = 0; It < Iterations; ++It)
+			{
+				Serial.Detected = 0;
+				for (const FQuircLumaImage& Image : Images)
+				{
+					TArray<FQRDetection> Detections;
+					FQuircReader::DecodeFromLuma(Image.Luma, Image.Width, Image.Height, Image.Stride, Detections);
+					Serial.Detected += Detections.Num();
+				}
+			}
+			uint64 T1 = FPlatformTime::Cycles64();
+			Serial.NsPerFrame = FPlatformTime::ToSeconds64(T1 - T0) * 1e9 / FMath::Max(1, Serial.Frames);
+
+			FQuircReader::ResetDecodeCache();
+			T0 = FPlatformTime::Cycles64();
+			for (int32 It = 0; It < Iterations; ++It)
+			{
+				Batch.Detected = FQuircReader::DecodeBatch(Images, Results);
+			}
+			T1 = FPlatformTime::Cycles64();
+			Batch.NsPerFrame = FPlatformTime::ToSeconds64(T1 - T0) * 1e9 / FMath::Max(1, Batch.Frames);
+
+			Out.Add(MoveTemp(Serial));
+			Out.Add(MoveTemp(Batch));
+		}
+	}
+
+	// End-to-end FQuircReader::DecodeFromLuma on synthetic camera frames: one frame
+	// per version 1 to 40 and capture condition. Recall counts payloads returned
+	// verbatim; ns and allocations cover the whole DecodeFromLuma call.
+	static void RunRecall(int32 W, int32 H, TArray<FResult>& Out)
+	{
+		static const ESceneKind Kinds[] = {
+			ESceneKind::Clean, ESceneKind::Perspective, ESceneKind::Blur,
+			ESceneKind::Noise, ESceneKind::LowContrast, ESceneKind::MultiCode,
+			ESceneKind::Gradient
+		};
+
+		for (ESceneKind Kind : Kinds)
+		{
+			FRandomStream Rng(/*Seed*/ 1234);
+			FResult R;
+			R.Scenario = FString::Printf(TEXT("Recall/%s"), SceneKindName(Kind));
+			R.Variant = TEXT("DecodeFromLuma");
+			R.Width = W;
+			R.Height = H;
+
+			// Prefilter on the same frames: expected counts frames DecodeFromLuma read at
+			// least one code from, detected those the prefilter let through, so a recall
+			// below 1 means frames the prefilter would have lost.
+			FResult P;
+			P.Scenario = R.Scenario;
+			P.Variant = TEXT("Prefilter");
+			P.Width = W;
+			P.Height = H;
+
+			double Seconds = 0.0;
+			double PrefilterSeconds = 0.0;
+			uint64 NumAllocs = 0;
+
+			for (int32 Version = 1; Version <= 40; ++Version)
+			{
+				FScene Scene;
+				if (!MakeScene(Kind, Version, W, H, Rng, Scene))
+				{
+					continue;
+				}
+
+				bool bCandidates = false;
+				{
+					const uint64 T0 = FPlatformTime::Cycles64();
+					bCandidates = FQuircReader::HasFinderCandidates(Scene.Luma.GetData(), W, H, W);
+					const uint64 T1 = FPlatformTime::Cycles64();
+
+					PrefilterSeconds += FPlatformTime::ToSeconds64(T1 - T0);
+					++P.Frames;
+				}
+
+				TArray<FQRDetection> Detections;
+				{
+					FScopedAllocCounter Allocs;
+					const uint64 T0 = FPlatformTime::Cycles64();
+					FQuircReader::DecodeFromLuma(Scene.Luma.GetData(), W, H, W, Detections);
+					const uint64 T1 = FPlatformTime::Cycles64();
+
+					Seconds += FPlatformTime::ToSeconds64(T1 - T0);
+					NumAllocs += Allocs.GetNumAllocs();
+				}
+
+				++R.Frames;
+				R.Expected += Scene.Payloads.Num();
+				bool bDecoded = false;
+				for (const FString& Payload : Scene.Payloads)
+				{
+					if (Detections.ContainsByPredicate([&Payload](const FQRDetection& D) { return D.Text == Payload; }))
+					{
+						++R.Detected;
+						bDecoded = true;
+					}
+				}
+
+				if (bDecoded)
+				{
+					++P.Expected;
+					P.Detected += bCandidates ? 1 : 0;
+				}
+			}
+
+			R.NsPerFrame = Seconds * 1e9 / FMath::Max(1, R.Frames);
+			R.AllocsPerFrame = static_cast<double>(NumAllocs) / FMath::Max(1, R.Frames);
+			Out.Add(MoveTemp(R));
+
+			P.NsPerFrame = PrefilterSeconds * 1e9 / FMath::Max(1, P.Frames);
+			Out.Add(MoveTemp(P));
+		}
+	}
+}
+
+UQuircBenchmarkCommandlet::UQuircBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UQuircBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace QuircBenchmark;
+
+	FString Scenario = TEXT("All");
+	FString OutputPath;
+	int32 Width = 1920;
+	int32 Height = 1080;
+	int32 Frames = 30;
+
+	FParse::Value(*Params, TEXT("Scenario="), Scenario);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	const bool bWidth = FParse::Value(*Params, TEXT("Width="), Width);
+	const bool bHeight = FParse::Value(*Params, TEXT("Height="), Height);
+	FParse::Value(*Params, TEXT("Frames="), Frames);
+	bTimingReject = FParse::Param(*Params, TEXT("TimingReject"));
+	FQuircReader::SetTimingReject(bTimingReject);
+
+	if (Width <= 0 || Height <= 0 || Frames <= 0)
+	{
+		UE_LOG(LogQuircBenchmark, Error, TEXT("Invalid -Width/-Height/-Frames"));
+		return 1;
+	}
+
+	TArray<FResult> Results;
+	const bool bAll = Scenario.Equals(TEXT("All"), ESearchCase::IgnoreCase);
+
+	if (bAll || Scenario.Equals(TEXT("Labeling"), ESearchCase::IgnoreCase))
+	{
+		RunLabeling(Width, Height, Frames, Results);
+	}
+
+	if (bAll || Scenario.Equals(TEXT("Capacity"), ESearchCase::IgnoreCase))
+	{
+		// 1080p and 4K, where the region table runs out, unless asked otherwise.
+		if (bWidth || bHeight)
+		{
+			RunCapacity(Width, Height, Frames, Results);
+		}
+		else
+		{
+			RunCapacity(1920, 1080, Frames, Results);
+			RunCapacity(3840, 2160, Frames, Results);
+		}
+	}
+
+	if (bAll || Scenario.Equals(TEXT("Perspective"), ESearchCase::IgnoreCase))
+	{
+		RunPerspective(Width, Height, FMath::Max(1, Frames / 10), Results);
+	}
+
+	if (bAll || Scenario.Equals(TEXT("Decode"), ESearchCase::IgnoreCase))
+	{
+		RunDecode(Frames, Results);
+	}
+
+	if (bAll || Scenario.Equals(TEXT("Batch"), ESearchCase::IgnoreCase))
+	{
+		RunBatch(Width, Height, Frames, Results);
+	}
+
+	if (bAll || Scenario.Equals(TEXT("Recall"), ESearchCase::IgnoreCase))
+	{
+		// Camera feed sizes unless a resolution was asked for explicitly.
+		if (bWidth || bHeight)
+		{
+			RunRecall(Width, Height, Results);
+		}
+		else
+		{
+			RunRecall(1280, 720, Results);
+			RunRecall(1920, 1080, Results);
+		}
+	}
+
+	if (Results.Num() == 0)
+	{
+		UE_LOG(LogQuircBenchmark, Error, TEXT("Unknown scenario '%s'"), *Scenario);
+		return 1;
+	}
+
+	TArray<FString> Lines;
+	for (const FResult& R : Results)
+	{
+		Lines.Add(R.ToJson());
+		UE_LOG(LogQuircBenchmark, Display, TEXT("%s"), *Lines.Last());
+	}
+
+	if (!OutputPath.IsEmpty() && !FFileHelper::SaveStringArrayToFile(Lines, *OutputPath))
+	{
+		UE_LOG(LogQuircBenchmark, Error, TEXT("Could not write %s"), *OutputPath);
+		return 1;
+	}
+
+	return 0;
+}
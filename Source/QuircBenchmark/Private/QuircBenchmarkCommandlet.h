@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "QuircBenchmarkCommandlet.generated.h"
+
+/**
+ * Headless quirc benchmark.
+ *
+ * Usage: UnrealEditor-Cmd Cam2Android.uproject -run=QuircBenchmark [-Scenario=Labeling|Capacity|Perspective|Decode|Batch|Recall] [-Width=1920] [-Height=1080] [-Frames=30] [-Output=Path.json] [-TimingReject]
+ * Each result is logged as one JSON object per line (and written to -Output when given).
+ * Labeling and Capacity compare flood fill, union-find and FloodFillRetry (flood fill,
+ * then union-find only when it runs out of regions, as FQuircReader decodes).
+ * Capacity pastes six codes over dense textures at 1080p and 4K (or -Width/-Height)
+ * and reports how many each labeller recovers, with ns per quirc_end.
+ * Perspective times quirc_end on keystoned codes (versions 1-40, Frames/10 passes),
+ * where grid refinement dominates.
+ * Decode results report ns per quirc_decode call; width/height hold the grid size in
+ * modules and detected counts the ECC levels (of 4) that decoded correctly.
+ * Batch decodes 1, 2, 4 and 8 frames per call with FQuircReader::DecodeBatch and
+ * the same frames one DecodeFromLuma at a time; ns is per image.
+ * Recall runs FQuircReader::DecodeFromLuma on synthetic frames (versions 1-40 under
+ * perspective, blur, noise, low contrast, several codes per frame and uneven
+ * lighting) at 720p and 1080p, or at -Width/-Height when given, and adds recall and
+ * allocs_per_frame. A Prefilter variant times FQuircReader::HasFinderCandidates on
+ * the same frames; its recall is the share of decodable frames it lets through.
+ * -TimingReject enables quirc_set_timing_reject on every decoder.
+ */
+UCLASS()
+class UQuircBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UQuircBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
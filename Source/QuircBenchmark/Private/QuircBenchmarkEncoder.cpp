@@ -0,0 +1,429 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+#include "QuircBenchmarkEncoder.h"
+
+extern "C" {
+	#include "quirc_internal.h"
+}
+
+namespace QuircBenchmark
+{
+	namespace
+	{
+		struct FGf256
+		{
+			uint8 Exp[512];
+			uint8 Log[256];
+
+			FGf256()
+			{
+				int32 X = 1;
+				for (int32 i = 0; i < 255; ++i)
+				{
+					Exp[i] = static_cast<uint8>(X);
+					Log[X] = static_cast<uint8>(i);
+					X <<= 1;
+					if (X & 0x100)
+					{
+						X ^= 0x11d;
+					}
+				}
+				for (int32 i = 255; i < 512; ++i)
+				{
+					Exp[i] = Exp[i - 255];
+				}
+				Log[0] = 0;
+			}
+
+			uint8 Mul(uint8 A, uint8 B) const
+			{
+				return (A && B) ? Exp[Log[A] + Log[B]] : 0;
+			}
+		};
+
+		const FGf256& Gf()
+		{
+			static const FGf256 Field;
+			return Field;
+		}
+
+		// Remainder of Data(x) * x^NumParity by the generator prod (x - a^i).
+		void ComputeParity(const uint8* Data, int32 NumData, int32 NumParity, uint8* OutParity)
+		{
+			const FGf256& F = Gf();
+
+			TArray<uint8> Gen;
+			Gen.Init(0, NumParity + 1);
+			Gen[0] = 1;
+			for (int32 i = 0; i < NumParity; ++i)
+			{
+				for (int32 j = i + 1; j > 0; --j)
+				{
+					Gen[j] = Gen[j - 1] ^ F.Mul(Gen[j], F.Exp[i]);
+				}
+				Gen[0] = F.Mul(Gen[0], F.Exp[i]);
+			}
+
+			TArray<uint8> Rem;
+			Rem.Init(0, NumParity);
+			for (int32 i = 0; i < NumData; ++i)
+			{
+				const uint8 Factor = Data[i] ^ Rem[0];
+				FMemory::Memmove(Rem.GetData(), Rem.GetData() + 1, NumParity - 1);
+				Rem[NumParity - 1] = 0;
+				for (int32 j = 0; j < NumParity; ++j)
+				{
+					Rem[j] ^= F.Mul(Gen[NumParity - 1 - j], Factor);
+				}
+			}
+
+			FMemory::Memcpy(OutParity, Rem.GetData(), NumParity);
+		}
+
+		// Same function-pattern layout quirc's decoder skips when reading codewords.
+		bool IsReserved(int32 Version, int32 I, int32 J)
+		{
+			const quirc_version_info& Ver = quirc_version_db[Version];
+			const int32 Size = Version * 4 + 17;
+
+			if (I < 9 && J < 9) return true;
+			if (I + 8 >= Size && J < 9) return true;
+			if (I < 9 && J + 8 >= Size) return true;
+			if (I == 6 || J == 6) return true;
+
+			if (Version >= 7)
+			{
+				if (I < 6 && J + 11 >= Size) return true;
+				if (I + 11 >= Size && J < 6) return true;
+			}
+
+			int32 AI = -1, AJ = -1, A = 0;
+			for (; A < QUIRC_MAX_ALIGNMENT && Ver.apat[A]; ++A)
+			{
+				const int32 P = Ver.apat[A];
+				if (FMath::Abs(P - I) < 3) AI = A;
+				if (FMath::Abs(P - J) < 3) AJ = A;
+			}
+
+			if (AI >= 0 && AJ >= 0)
+			{
+				--A;
+				if (AI > 0 && AI < A) return true;
+				if (AJ > 0 && AJ < A) return true;
+				if (AJ == A && AI == A) return true;
+			}
+
+			return false;
+		}
+
+		bool MaskBit(int32 Mask, int32 I, int32 J)
+		{
+			switch (Mask)
+			{
+			case 0: return !((I + J) % 2);
+			case 1: return !(I % 2);
+			case 2: return !(J % 3);
+			case 3: return !((I + J) % 3);
+			case 4: return !(((I / 2) + (J / 3)) % 2);
+			case 5: return !((I * J) % 2 + (I * J) % 3);
+			case 6: return !(((I * J) % 2 + (I * J) % 3) % 2);
+			case 7: return !(((I * J) % 3 + (I + J) % 2) % 2);
+			default: return false;
+			}
+		}
+	}
+
+	bool EncodeQR(const TArray<uint8>& Payload, int32 Version, int32 EccLevel, int32 Mask,
+	              TArray<uint8>& OutModules, int32& OutSize, TArray<int32>* OutDataCells)
+	{
+		if (Version < 1 || Version > QUIRC_MAX_VERSION || EccLevel < 0 || EccLevel > 3 || Mask < 0 || Mask > 7)
+		{
+			return false;
+		}
+
+		const quirc_version_info& Ver = quirc_version_db[Version];
+		const quirc_rs_params& Small = Ver.ecc[EccLevel];
+		const int32 NumLarge = (Ver.data_bytes - Small.bs * Small.ns) / (Small.bs + 1);
+		const int32 NumBlocks = Small.ns + NumLarge;
+		const int32 NumData = Small.dw * Small.ns + (Small.dw + 1) * NumLarge;
+		const int32 NumParity = Small.bs - Small.dw;
+		const int32 LengthBits = Version < 10 ? 8 : 16;
+
+		if (4 + LengthBits + Payload.Num() * 8 > NumData * 8)
+		{
+			return false;
+		}
+
+		// Byte-mode bit stream, terminator and pad codewords.
+		TArray<uint8> Data;
+		Data.Init(0, NumData);
+		int32 Bit = 0;
+		auto Put = [&Data, &Bit](int32 Value, int32 NumBits)
+		{
+			for (int32 i = NumBits - 1; i >= 0; --i, ++Bit)
+			{
+				if ((Value >> i) & 1)
+				{
+					Data[Bit >> 3] |= 0x80 >> (Bit & 7);
+				}
+			}
+		};
+
+		Put(4, 4);
+		Put(Payload.Num(), LengthBits);
+		for (uint8 C : Payload)
+		{
+			Put(C, 8);
+		}
+
+		const int32 Capacity = NumData * 8;
+		Bit = FMath::Min(Bit + 4, Capacity);
+		Bit = (Bit + 7) & ~7;
+		for (int32 Pad = 0; Bit < Capacity; ++Pad)
+		{
+			Put((Pad & 1) ? 0x11 : 0xEC, 8);
+		}
+
+		// Split into blocks, append parity and interleave.
+		TArray<uint8> Raw;
+		Raw.Reserve(Ver.data_bytes);
+		{
+			TArray<TArray<uint8>> Blocks;
+			TArray<TArray<uint8>> Parity;
+			Blocks.SetNum(NumBlocks);
+			Parity.SetNum(NumBlocks);
+
+			int32 Offset = 0;
+			for (int32 i = 0; i < NumBlocks; ++i)
+			{
+				const int32 DW = (i < Small.ns) ? Small.dw : Small.dw + 1;
+				Blocks[i].Append(Data.GetData() + Offset, DW);
+				Offset += DW;
+
+				Parity[i].SetNumZeroed(NumParity);
+				ComputeParity(Blocks[i].GetData(), DW, NumParity, Parity[i].GetData());
+			}
+
+			for (int32 j = 0; j <= Small.dw; ++j)
+			{
+				for (int32 i = 0; i < NumBlocks; ++i)
+				{
+					if (j < Blocks[i].Num())
+					{
+						Raw.Add(Blocks[i][j]);
+					}
+				}
+			}
+			for (int32 j = 0; j < NumParity; ++j)
+			{
+				for (int32 i = 0; i < NumBlocks; ++i)
+				{
+					Raw.Add(Parity[i][j]);
+				}
+			}
+		}
+
+		const int32 Size = Version * 4 + 17;
+		OutSize = Size;
+		OutModules.Init(0, Size * Size);
+
+		auto Set = [&OutModules, Size](int32 Row, int32 Col, bool bDark)
+		{
+			if (Row >= 0 && Col >= 0 && Row < Size && Col < Size)
+			{
+				OutModules[Row * Size + Col] = bDark ? 1 : 0;
+			}
+		};
+
+		// Finder patterns with separators, timing and alignment patterns.
+		auto Finder = [&Set](int32 R0, int32 C0)
+		{
+			for (int32 R = -1; R <= 7; ++R)
+			{
+				for (int32 C = -1; C <= 7; ++C)
+				{
+					const bool bInside = R >= 0 && R <= 6 && C >= 0 && C <= 6;
+					const bool bRing = R == 0 || R == 6 || C == 0 || C == 6;
+					const bool bCore = R >= 2 && R <= 4 && C >= 2 && C <= 4;
+					Set(R0 + R, C0 + C, bInside && (bRing || bCore));
+				}
+			}
+		};
+		Finder(0, 0);
+		Finder(0, Size - 7);
+		Finder(Size - 7, 0);
+
+		for (int32 i = 8; i < Size - 8; ++i)
+		{
+			Set(6, i, !(i & 1));
+			Set(i, 6, !(i & 1));
+		}
+
+		int32 NumAlign = 0;
+		while (NumAlign < QUIRC_MAX_ALIGNMENT && Ver.apat[NumAlign])
+		{
+			++NumAlign;
+		}
+		for (int32 A = 0; A < NumAlign; ++A)
+		{
+			for (int32 B = 0; B < NumAlign; ++B)
+			{
+				if ((A == 0 && B == 0) || (A == 0 && B == NumAlign - 1) || (A == NumAlign - 1 && B == 0))
+				{
+					continue;
+				}
+				for (int32 DR = -2; DR <= 2; ++DR)
+				{
+					for (int32 DC = -2; DC <= 2; ++DC)
+					{
+						Set(Ver.apat[A] + DR, Ver.apat[B] + DC,
+						    FMath::Abs(DR) == 2 || FMath::Abs(DC) == 2 || (DR == 0 && DC == 0));
+					}
+				}
+			}
+		}
+
+		Set(Size - 8, 8, true);
+
+		// Codeword placement in the usual two-column zigzag, masked.
+		if (OutDataCells)
+		{
+			OutDataCells->Reset();
+		}
+
+		const int32 TotalBits = Raw.Num() * 8;
+		int32 NextBit = 0;
+		auto Write = [&](int32 I, int32 J)
+		{
+			bool bDark = false;
+			if (NextBit < TotalBits)
+			{
+				bDark = (Raw[NextBit >> 3] >> (7 - (NextBit & 7))) & 1;
+				if (OutDataCells)
+				{
+					OutDataCells->Add(I * Size + J);
+				}
+			}
+			++NextBit;
+			OutModules[I * Size + J] = (bDark != MaskBit(Mask, I, J)) ? 1 : 0;
+		};
+
+		for (int32 Y = Size - 1, X = Size - 1, Dir = -1; X > 0;)
+		{
+			if (X == 6)
+			{
+				--X;
+			}
+			if (!IsReserved(Version, Y, X))
+			{
+				Write(Y, X);
+			}
+			if (!IsReserved(Version, Y, X - 1))
+			{
+				Write(Y, X - 1);
+			}
+
+			Y += Dir;
+			if (Y < 0 || Y >= Size)
+			{
+				Dir = -Dir;
+				X -= 2;
+				Y += Dir;
+			}
+		}
+
+		// Format information: BCH(15,5) over the ECC level and mask.
+		{
+			const int32 FormatData = (EccLevel << 3) | Mask;
+			int32 Rem = FormatData << 10;
+			for (int32 i = 14; i >= 10; --i)
+			{
+				if (Rem & (1 << i))
+				{
+					Rem ^= 0x537 << (i - 10);
+				}
+			}
+			const int32 Format = ((FormatData << 10) | Rem) ^ 0x5412;
+
+			static const int32 XS[15] = { 8, 8, 8, 8, 8, 8, 8, 8, 7, 5, 4, 3, 2, 1, 0 };
+			static const int32 YS[15] = { 0, 1, 2, 3, 4, 5, 7, 8, 8, 8, 8, 8, 8, 8, 8 };
+			for (int32 i = 0; i < 15; ++i)
+			{
+				OutModules[YS[i] * Size + XS[i]] = (Format >> i) & 1;
+			}
+			for (int32 i = 0; i < 7; ++i)
+			{
+				OutModules[(Size - 1 - i) * Size + 8] = (Format >> (14 - i)) & 1;
+			}
+			for (int32 i = 0; i < 8; ++i)
+			{
+				OutModules[8 * Size + Size - 8 + i] = (Format >> (7 - i)) & 1;
+			}
+		}
+
+		// Version information: BCH(18,6), versions 7 and up.
+		if (Version >= 7)
+		{
+			int32 Info = Version << 12;
+			for (int32 i = 17; i >= 12; --i)
+			{
+				if (Info & (1 << i))
+				{
+					Info ^= 0x1f25 << (i - 12);
+				}
+			}
+			Info |= Version << 12;
+
+			for (int32 i = 0; i < 18; ++i)
+			{
+				const uint8 B = (Info >> i) & 1;
+				OutModules[(Size - 11 + i % 3) * Size + i / 3] = B;
+				OutModules[(i / 3) * Size + Size - 11 + i % 3] = B;
+			}
+		}
+
+		return true;
+	}
+
+	int32 CorrectableCodewords(int32 Version, int32 EccLevel)
+	{
+		if (Version < 1 || Version > QUIRC_MAX_VERSION || EccLevel < 0 || EccLevel > 3)
+		{
+			return 0;
+		}
+
+		const quirc_version_info& Ver = quirc_version_db[Version];
+		const quirc_rs_params& Small = Ver.ecc[EccLevel];
+		const int32 NumLarge = (Ver.data_bytes - Small.bs * Small.ns) / (Small.bs + 1);
+		return (Small.ns + NumLarge) * ((Small.bs - Small.dw) / 2);
+	}
+
+	void BlitQR(TArray<uint8>& Img, int32 W, int32 H, const TArray<uint8>& Modules, int32 Size,
+	            int32 Scale, int32 OX, int32 OY)
+	{
+		const int32 Total = (Size + 8) * Scale;
+		for (int32 Y = 0; Y < Total; ++Y)
+		{
+			const int32 PY = OY + Y;
+			if (PY < 0 || PY >= H)
+			{
+				continue;
+			}
+
+			for (int32 X = 0; X < Total; ++X)
+			{
+				const int32 PX = OX + X;
+				if (PX < 0 || PX >= W)
+				{
+					continue;
+				}
+
+				const int32 MX = X / Scale - 4;
+				const int32 MY = Y / Scale - 4;
+				const bool bDark = MX >= 0 && MY >= 0 && MX < Size && MY < Size && Modules[MY * Size + MX];
+				Img[PY * W + PX] = bDark ? 0 : 255;
+			}
+		}
+	}
+}
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace QuircBenchmark
+{
+	/**
+	 * Minimal QR encoder (byte mode) used to build benchmark corpora. Block layout
+	 * and alignment patterns come from quirc's own version database, so anything it
+	 * produces is a grid quirc can read back.
+	 *
+	 * @param Payload   Bytes to encode; must fit the version/ECC capacity
+	 * @param Version   1..40
+	 * @param EccLevel  quirc ECC index (QUIRC_ECC_LEVEL_M/L/H/Q)
+	 * @param Mask      0..7
+	 * @param OutModules Size*Size modules, row major, 1 = dark
+	 * @param OutSize   Modules per side
+	 * @param OutDataCells Optional indices of cells that carry codewords, for error injection
+	 * @return false if the payload doesn't fit.
+	 */
+	bool EncodeQR(const TArray<uint8>& Payload, int32 Version, int32 EccLevel, int32 Mask,
+	              TArray<uint8>& OutModules, int32& OutSize, TArray<int32>* OutDataCells = nullptr);
+
+	/** Codewords the ECC blocks of a version/level can correct in total (half the parity bytes). */
+	int32 CorrectableCodewords(int32 Version, int32 EccLevel);
+
+	/** Draws a module matrix with a 4-module quiet zone at (OX, OY), Scale pixels per module. */
+	void BlitQR(TArray<uint8>& Img, int32 W, int32 H, const TArray<uint8>& Modules, int32 Size,
+	            int32 Scale, int32 OX, int32 OY);
+}
@@ -0,0 +1,7 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+#include "Modules/ModuleManager.h"
+
+// Módulo de editor: commandlet, escenas sintéticas y codificador QR de prueba, fuera del runtime de Quirc.
+IMPLEMENT_MODULE(FDefaultModuleImpl, QuircBenchmark)
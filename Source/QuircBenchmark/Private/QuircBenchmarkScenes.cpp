@@ -0,0 +1,308 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+
+#include "QuircBenchmarkScenes.h"
+#include "QuircBenchmarkEncoder.h"
+
+namespace QuircBenchmark
+{
+	namespace
+	{
+		// Homography from the unit square to a quad (TL, TR, BR, BL), row major 3x3.
+		struct FHomography
+		{
+			double M[9];
+
+			static FHomography SquareToQuad(const FVector2D* Q)
+			{
+				FHomography H;
+				const double DX1 = Q[1].X - Q[2].X, DX2 = Q[3].X - Q[2].X, DX3 = Q[0].X - Q[1].X + Q[2].X - Q[3].X;
+				const double DY1 = Q[1].Y - Q[2].Y, DY2 = Q[3].Y - Q[2].Y, DY3 = Q[0].Y - Q[1].Y + Q[2].Y - Q[3].Y;
+
+				double G = 0.0, Hh = 0.0;
+				const double Det = DX1 * DY2 - DX2 * DY1;
+				if (Det != 0.0)
+				{
+					G = (DX3 * DY2 - DX2 * DY3) / Det;
+					Hh = (DX1 * DY3 - DX3 * DY1) / Det;
+				}
+
+				H.M[0] = Q[1].X - Q[0].X + G * Q[1].X;
+				H.M[1] = Q[3].X - Q[0].X + Hh * Q[3].X;
+				H.M[2] = Q[0].X;
+				H.M[3] = Q[1].Y - Q[0].Y + G * Q[1].Y;
+				H.M[4] = Q[3].Y - Q[0].Y + Hh * Q[3].Y;
+				H.M[5] = Q[0].Y;
+				H.M[6] = G;
+				H.M[7] = Hh;
+				H.M[8] = 1.0;
+				return H;
+			}
+
+			// Adjugate; the scale doesn't matter for a projective map.
+			FHomography Inverse() const
+			{
+				FHomography R;
+				R.M[0] = M[4] * M[8] - M[5] * M[7];
+				R.M[1] = M[2] * M[7] - M[1] * M[8];
+				R.M[2] = M[1] * M[5] - M[2] * M[4];
+				R.M[3] = M[5] * M[6] - M[3] * M[8];
+				R.M[4] = M[0] * M[8] - M[2] * M[6];
+				R.M[5] = M[2] * M[3] - M[0] * M[5];
+				R.M[6] = M[3] * M[7] - M[4] * M[6];
+				R.M[7] = M[1] * M[6] - M[0] * M[7];
+				R.M[8] = M[0] * M[4] - M[1] * M[3];
+				return R;
+			}
+
+			bool Map(double X, double Y, double& OutX, double& OutY) const
+			{
+				const double Wd = M[6] * X + M[7] * Y + M[8];
+				if (Wd == 0.0)
+				{
+					return false;
+				}
+				OutX = (M[0] * X + M[1] * Y + M[2]) / Wd;
+				OutY = (M[3] * X + M[4] * Y + M[5]) / Wd;
+				return true;
+			}
+		};
+
+		// Draws a code (quiet zone included) into Quad with 2x2 supersampling.
+		void RenderCode(FScene& Scene, const TArray<uint8>& Modules, int32 Size, const FVector2D* Quad, uint8 Dark, uint8 Light)
+		{
+			const FHomography ToImage = FHomography::SquareToQuad(Quad);
+			const FHomography ToCode = ToImage.Inverse();
+			const int32 Span = Size + 8;
+
+			double MinX = Quad[0].X, MaxX = Quad[0].X, MinY = Quad[0].Y, MaxY = Quad[0].Y;
+			for (int32 i = 1; i < 4; ++i)
+			{
+				MinX = FMath::Min(MinX, Quad[i].X);
+				MaxX = FMath::Max(MaxX, Quad[i].X);
+				MinY = FMath::Min(MinY, Quad[i].Y);
+				MaxY = FMath::Max(MaxY, Quad[i].Y);
+			}
+
+			const int32 X0 = FMath::Max(0, FMath::FloorToInt(MinX));
+			const int32 Y0 = FMath::Max(0, FMath::FloorToInt(MinY));
+			const int32 X1 = FMath::Min(Scene.Width - 1, FMath::CeilToInt(MaxX));
+			const int32 Y1 = FMath::Min(Scene.Height - 1, FMath::CeilToInt(MaxY));
+
+			for (int32 Y = Y0; Y <= Y1; ++Y)
+			{
+				for (int32 X = X0; X <= X1; ++X)
+				{
+					int32 Inside = 0;
+					int32 NumDark = 0;
+
+					for (int32 S = 0; S < 4; ++S)
+					{
+						double U, V;
+						if (!ToCode.Map(X + 0.25 + 0.5 * (S & 1), Y + 0.25 + 0.5 * (S >> 1), U, V) ||
+						    U < 0.0 || V < 0.0 || U >= 1.0 || V >= 1.0)
+						{
+							continue;
+						}
+
+						++Inside;
+						const int32 MX = static_cast<int32>(U * Span) - 4;
+						const int32 MY = static_cast<int32>(V * Span) - 4;
+						if (MX >= 0 && MY >= 0 && MX < Size && MY < Size && Modules[MY * Size + MX])
+						{
+							++NumDark;
+						}
+					}
+
+					if (Inside > 0)
+					{
+						uint8& P = Scene.Luma[Y * Scene.Width + X];
+						const int32 Cover = (Inside * 255) / 4;
+						const int32 Code = (NumDark * Dark + (Inside - NumDark) * Light) / Inside;
+						P = static_cast<uint8>((Code * Cover + P * (255 - Cover)) / 255);
+					}
+				}
+			}
+		}
+
+		// Separable box blur, run twice for a roughly Gaussian profile.
+		void BoxBlur(FScene& Scene, int32 Radius)
+		{
+			const int32 W = Scene.Width;
+			const int32 H = Scene.Height;
+			TArray<uint8> Tmp;
+			Tmp.SetNumUninitialized(W * H);
+
+			auto Pass = [Radius](const uint8* Src, uint8* Dst, int32 Count, int32 Step)
+			{
+				const int32 Window = 2 * Radius + 1;
+				int32 Sum = 0;
+				for (int32 i = -Radius; i <= Radius; ++i)
+				{
+					Sum += Src[FMath::Clamp(i, 0, Count - 1) * Step];
+				}
+				for (int32 i = 0; i < Count; ++i)
+				{
+					Dst[i * Step] = static_cast<uint8>(Sum / Window);
+					Sum += Src[FMath::Min(i + Radius + 1, Count - 1) * Step];
+					Sum -= Src[FMath::Max(i - Radius, 0) * Step];
+				}
+			};
+
+			for (int32 Iter = 0; Iter < 2; ++Iter)
+			{
+				for (int32 Y = 0; Y < H; ++Y)
+				{
+					Pass(Scene.Luma.GetData() + Y * W, Tmp.GetData() + Y * W, W, 1);
+				}
+				for (int32 X = 0; X < W; ++X)
+				{
+					Pass(Tmp.GetData() + X, Scene.Luma.GetData() + X, H, W);
+				}
+			}
+		}
+
+		void AddNoise(FScene& Scene, FRandomStream& Rng, float Sigma)
+		{
+			// Sum of four uniforms: close enough to Gaussian for a benchmark.
+			for (uint8& P : Scene.Luma)
+			{
+				const float N = (Rng.FRand() + Rng.FRand() + Rng.FRand() + Rng.FRand() - 2.0f) * Sigma * 1.732f;
+				P = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(P + N), 0, 255));
+			}
+		}
+
+		// Light falling off from one corner to a quarter, and a hard-edged shadow over
+		// the right part of the frame (and of the code) that halves it again.
+		void ApplyUnevenLighting(FScene& Scene)
+		{
+			const int32 W = Scene.Width;
+			const int32 H = Scene.Height;
+
+			for (int32 Y = 0; Y < H; ++Y)
+			{
+				uint8* Row = Scene.Luma.GetData() + Y * W;
+				const int32 ShadowX = static_cast<int32>(W * (0.55 + 0.1 * Y / H));
+
+				for (int32 X = 0; X < W; ++X)
+				{
+					const double Ramp = 0.7 * X / W + 0.3 * Y / H;
+					double Gain = FMath::Lerp(1.0, 0.25, Ramp);
+					if (X >= ShadowX)
+					{
+						Gain *= 0.5;
+					}
+					Row[X] = static_cast<uint8>(FMath::RoundToInt(Row[X] * Gain));
+				}
+			}
+		}
+
+		// Axis-aligned square of side Side centred at Center, optionally rotated/keystoned.
+		void MakeQuad(const FVector2D& Center, double Side, double Angle, double Jitter, FRandomStream& Rng, FVector2D* OutQuad)
+		{
+			static const double CX[4] = { -0.5, 0.5, 0.5, -0.5 };
+			static const double CY[4] = { -0.5, -0.5, 0.5, 0.5 };
+			const double C = FMath::Cos(Angle);
+			const double S = FMath::Sin(Angle);
+
+			for (int32 i = 0; i < 4; ++i)
+			{
+				const double X = (CX[i] + Jitter * (Rng.FRand() * 2.0 - 1.0)) * Side;
+				const double Y = (CY[i] + Jitter * (Rng.FRand() * 2.0 - 1.0)) * Side;
+				OutQuad[i] = FVector2D(Center.X + C * X - S * Y, Center.Y + S * X + C * Y);
+			}
+		}
+	}
+
+	const TCHAR* SceneKindName(ESceneKind Kind)
+	{
+		switch (Kind)
+		{
+		case ESceneKind::Clean:       return TEXT("Clean");
+		case ESceneKind::Perspective: return TEXT("Perspective");
+		case ESceneKind::Blur:        return TEXT("Blur");
+		case ESceneKind::Noise:       return TEXT("Noise");
+		case ESceneKind::LowContrast: return TEXT("LowContrast");
+		case ESceneKind::Gradient:    return TEXT("Gradient");
+		default:                      return TEXT("MultiCode");
+		}
+	}
+
+	bool MakeScene(ESceneKind Kind, int32 Version, int32 W, int32 H, FRandomStream& Rng, FScene& Out)
+	{
+		Out.Width = W;
+		Out.Height = H;
+		Out.Luma.Init(170, W * H);
+		Out.Payloads.Reset();
+
+		const bool bMulti = Kind == ESceneKind::MultiCode;
+		const int32 NumCodes = bMulti ? 4 : 1;
+		const double Cell = bMulti ? FMath::Min(W, H) * 0.5 : FMath::Min(W, H);
+		const uint8 Dark = (Kind == ESceneKind::LowContrast) ? 110 : 20;
+		const uint8 Light = (Kind == ESceneKind::LowContrast) ? 150 : 235;
+		double ModulePx = 0.0;
+
+		for (int32 i = 0; i < NumCodes; ++i)
+		{
+			const FString Text = FString::Printf(TEXT("Q%d-%d-%d"), Version, i, Rng.RandHelper(10000));
+			const FTCHARToUTF8 Utf8(*Text);
+			TArray<uint8> Payload;
+			Payload.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+
+			TArray<uint8> Modules;
+			int32 Size = 0;
+			if (!EncodeQR(Payload, Version, /*QUIRC_ECC_LEVEL_M*/ 0, Rng.RandHelper(8), Modules, Size))
+			{
+				continue;
+			}
+
+			FVector2D Center(W * 0.5, H * 0.5);
+			if (bMulti)
+			{
+				Center = FVector2D((W * 0.5 - Cell * 0.5) + Cell * (i & 1), (H * 0.5 - Cell * 0.5) + Cell * (i >> 1));
+			}
+
+			double Side = Cell * 0.85;
+			double Angle = 0.0;
+			double Jitter = 0.0;
+			if (Kind == ESceneKind::Perspective)
+			{
+				Side = Cell * 0.7;
+				Angle = FMath::DegreesToRadians(Rng.FRandRange(-30.0f, 30.0f));
+				Jitter = 0.08;
+			}
+			else if (bMulti)
+			{
+				Angle = FMath::DegreesToRadians(Rng.FRandRange(-10.0f, 10.0f));
+			}
+
+			FVector2D Quad[4];
+			MakeQuad(Center, Side, Angle, Jitter, Rng, Quad);
+			RenderCode(Out, Modules, Size, Quad, Dark, Light);
+
+			ModulePx = Side / (Size + 8);
+			Out.Payloads.Add(Text);
+		}
+
+		switch (Kind)
+		{
+		case ESceneKind::Blur:
+			BoxBlur(Out, FMath::Max(1, FMath::RoundToInt(ModulePx / 5.0)));
+			break;
+		case ESceneKind::Noise:
+			AddNoise(Out, Rng, 25.0f);
+			break;
+		case ESceneKind::LowContrast:
+			AddNoise(Out, Rng, 4.0f);
+			break;
+		case ESceneKind::Gradient:
+			ApplyUnevenLighting(Out);
+			AddNoise(Out, Rng, 4.0f);
+			break;
+		default:
+			break;
+		}
+
+		return Out.Payloads.Num() > 0;
+	}
+}
@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2025-2026 Yesid Fonseca
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+namespace QuircBenchmark
+{
+	// Capture conditions for synthetic camera frames.
+	enum class ESceneKind : uint8
+	{
+		Clean,			// axis aligned, full contrast
+		Perspective,	// rotated and keystoned
+		Blur,			// defocus, about a fifth of a module
+		Noise,			// sensor noise
+		LowContrast,	// dim print / washed out exposure
+		MultiCode,		// four smaller codes in one frame
+		Gradient		// uneven lighting: brightness ramp plus a cast shadow
+	};
+
+	const TCHAR* SceneKindName(ESceneKind Kind);
+
+	struct FScene
+	{
+		int32 Width = 0;
+		int32 Height = 0;
+		TArray<uint8> Luma;			// Width * Height, stride == Width
+		TArray<FString> Payloads;	// texts a perfect reader would return
+	};
+
+	/**
+	 * Builds one frame containing version `Version` codes under the given condition.
+	 * Deterministic for a given stream seed.
+	 * @return false if nothing could be placed (frame too small for the version).
+	 */
+	bool MakeScene(ESceneKind Kind, int32 Version, int32 W, int32 H, FRandomStream& Rng, FScene& Out);
+}
@@ -0,0 +1,16 @@
+using UnrealBuildTool;
+using System.IO;
+
+public class QuircBenchmark : ModuleRules
+{
+    public QuircBenchmark(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+        bUseUnity = false;
+
+        PrivateDependencyModuleNames.AddRange(new[] { "Core", "CoreUObject", "Engine", "Quirc" });
+
+        // quirc.h: el commandlet mide la API C directamente; el codificador lee quirc_version_db.
+        PrivateIncludePaths.Add(Path.Combine(ModuleDirectory, "..", "Quirc", "ThirdParty", "lib"));
+    }
+}